@@ -0,0 +1,194 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "DPapprox.h"
+#include "generator.h"
+#include "perf_counters.h"
+
+/*
+ * bench solves a set of benchmark cases and reports the mean wall time of a solve per case. With --perf, it also
+ * reads the hardware counters (see perf_counters.h) around every solve and every phase of the labels DP, and reports
+ * their mean per solve, so that a change of layout can be checked against the cache and branch misses it causes.
+ *
+ * Usage: bench [--perf] [--repeat=<R>] [<case> ...]
+ *
+ * The cases are the examples with data (trj, sos, rck, lvf), run from build/examples, and generated problems
+ * (gen_sur, gen_sos, gen_state). Without a case, all of them run.
+ */
+
+using namespace DPapprox;
+
+namespace {
+
+struct Case {
+    std::string name;
+    std::function<std::vector<std::vector<double>>()> v_rel;
+    std::function<ProblemConfig(int)> config;
+};
+
+// the same minimum dwell time for every value of a single input.
+std::vector<std::pair<std::vector<int>, std::vector<double>>>
+dwell(const std::vector<int> &values, double min_dwell_time) {
+    std::vector<std::pair<std::vector<int>, std::vector<double>>> cons;
+    for (int v: values)
+        cons.push_back({{v}, {min_dwell_time}});
+    return cons;
+}
+
+ProblemConfig example(int N, double dt, std::vector<ProblemConfig::disc_vector> values,
+                      ProblemConfig::Strategy strategy) {
+    ProblemConfig config;
+    config.N = N;
+    config.dt = dt;
+    config.v_feasible.assign(N, values);
+    config.strategy = strategy;
+    return config;
+}
+
+GeneratorSpec spec(int N, std::size_t nv, double min_dwell_time, bool state) {
+    GeneratorSpec spec;
+    spec.N = N;
+    spec.nv = nv;
+    spec.min_dwell_time = min_dwell_time;
+    spec.state = state;
+    spec.chattering = 0.3;
+    spec.seed = 1;
+    return spec;
+}
+
+std::vector<Case> cases() {
+    const std::string data = "../../examples/data/";
+    auto csv = [data](const std::string &name) { return [=] { return read_csv(data + name + ".csv"); }; };
+    std::vector<Case> all;
+    all.push_back({"trj", csv("trj"), [](int N) {
+        ProblemConfig config = example(N, 0.02, {{1}, {0}, {-1}}, ProblemConfig::Strategy::SumUp);
+        config.dwell_time_cons = dwell({1, 0, -1}, 0.3);
+        return config;
+    }});
+    all.push_back({"sos", csv("sos"), [](int N) {
+        ProblemConfig config = example(N, 0.02, {{1, 0}, {0, 1}}, ProblemConfig::Strategy::SumUpInfNorm);
+        config.dwell_time_cons = {{{0}, {0.2, 0.2}}, {{1}, {0, 0}}};
+        return config;
+    }});
+    all.push_back({"rck", csv("rck"), [](int N) {
+        ProblemConfig config = example(N, 0.0005, {{0}, {1}}, ProblemConfig::Strategy::SumUp);
+        config.dwell_time_cons = dwell({1, 0}, 0.01);
+        return config;
+    }});
+    all.push_back({"lvf", csv("lvf"), [](int N) {
+        ProblemConfig config = example(N, 12.0 / N, {{0}, {1}}, ProblemConfig::Strategy::SumUp);
+        config.dwell_time_cons = dwell({0, 1}, 0.2);
+        return config;
+    }});
+    for (const auto &[name, s]: {std::pair{"gen_sur", spec(20000, 1, 0.05, false)},
+                                 std::pair{"gen_sos", spec(5000, 2, 0.05, false)},
+                                 std::pair{"gen_state", spec(5000, 1, 0.05, true)}})
+        all.push_back({name, [s = s] { return generate_relaxed(s); }, [s = s](int) { return generate_config(s); }});
+    return all;
+}
+
+void print(const std::string &name, const std::string &phase, double ms, const PerfSample &sample, int repeat) {
+    std::cout << std::left << std::setw(10) << name << std::setw(10) << phase << std::right << std::setw(12)
+              << std::fixed << std::setprecision(3) << ms;
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e) {
+        if (sample.valid[e])
+            std::cout << std::setw(14) << sample.count[e] / repeat;
+        else
+            std::cout << std::setw(14) << "-";
+    }
+    const bool ipc = sample.valid[PerfSample::Cycles] && sample.valid[PerfSample::Instructions] &&
+                     sample.count[PerfSample::Cycles] > 0;
+    std::cout << std::setw(8) << std::setprecision(2);
+    if (ipc)
+        std::cout << static_cast<double>(sample.count[PerfSample::Instructions]) / sample.count[PerfSample::Cycles];
+    else
+        std::cout << "-";
+    std::cout << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool perf = false;
+    int repeat = 5;
+    std::vector<std::string> selected;
+    for (int a = 1; a < argc; ++a) {
+        const std::string arg = argv[a];
+        if (arg == "--perf")
+            perf = true;
+        else if (arg.rfind("--repeat=", 0) == 0)
+            repeat = std::max(1, std::stoi(arg.substr(9)));
+        else
+            selected.push_back(arg);
+    }
+    DPapprox::Log.setThreshold(WARNING);
+
+    // the counters are opened once, on the thread that runs the solves.
+    std::unique_ptr<PerfCounters> counters = perf ? std::make_unique<PerfCounters>() : nullptr;
+    const char *phases[] = {"setup", "relax", "backtrack"};
+
+    std::cout << std::left << std::setw(10) << "case" << std::setw(10) << "phase" << std::right << std::setw(12)
+              << "ms";
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e)
+        std::cout << std::setw(14) << PerfSample::name(static_cast<PerfSample::Event>(e));
+    std::cout << std::setw(8) << "ipc" << std::endl;
+
+    for (const Case &c: cases()) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), c.name) == selected.end())
+            continue;
+        const std::vector<std::vector<double>> v_rel = c.v_rel();
+        if (v_rel.empty() || v_rel[0].empty()) {
+            std::cerr << "Error: no data for " << c.name << "." << std::endl;
+            continue;
+        }
+        ProblemConfig config = c.config(static_cast<int>(v_rel[0].size()));
+
+        // every phase adds its counts and time, from the sample taken when it was entered.
+        PerfSample phase_sample[3], phase_start[3];
+        double phase_ms[3] = {0, 0, 0};
+        std::chrono::steady_clock::time_point phase_clock[3];
+        config.phase_callback = [&](ProblemConfig::Phase phase, bool enter) {
+            const int p = static_cast<int>(phase);
+            if (enter) {
+                phase_clock[p] = std::chrono::steady_clock::now();
+                if (counters)
+                    phase_start[p] = counters->read();
+                return;
+            }
+            if (counters)
+                phase_sample[p] += counters->since(phase_start[p]);
+            phase_ms[p] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                     phase_clock[p]).count();
+        };
+
+        PerfSample total;
+        double total_ms = 0;
+        for (int r = 0; r < repeat; ++r) {
+            Solver solver(v_rel, config);
+            const PerfSample start = counters ? counters->read() : PerfSample{};
+            const auto t0 = std::chrono::steady_clock::now();
+            solver.solve();
+            total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (counters)
+                total += counters->since(start);
+        }
+        print(c.name, "solve", total_ms / repeat, total, repeat);
+        for (int p = 0; perf && p < 3; ++p)
+            print(c.name, phases[p], phase_ms[p] / repeat, phase_sample[p], repeat);
+    }
+    return 0;
+}
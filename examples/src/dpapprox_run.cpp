@@ -0,0 +1,279 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <optional>
+#include <limits>
+#include "DPapprox.h"
+
+/*
+ * dpapprox_run runs a batch of approximation jobs from a manifest, in a three stage pipeline: a reader thread parses
+ * the inputs ahead of the solvers, a pool of [workers] solves them, and a writer thread writes the results and prints
+ * the timing of every job, so that the I/O of a job overlaps the solves of the others.
+ *
+ * Usage: dpapprox_run <manifest> [workers]
+ *
+ * Each line of the manifest is a job, with '#' starting a comment:
+ *     <problem> <input.csv> <output.csv> [dt=<value>] [dwell=<value>] [k_best=<value>]
+ * where <problem> is the configuration of an example: mwe, trj, rck, lvf, sos or mat, solved by its built-in
+ * strategy. N is the number of columns of the input, [dt] replaces the time step, and [dwell] the minimum dwell time
+ * of every constraint of the example (trj, rck, lvf and sos).
+ */
+
+using namespace DPapprox;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Job {
+    std::size_t id{0};
+    std::string problem, input, output;
+    std::map<std::string, double> params;
+
+    std::vector<std::vector<double>> v_rel;
+    Solution solution;
+    std::string error;
+    Clock::time_point parsed, started;
+    double parse_ms{0}, wait_ms{0}, solve_ms{0}, write_ms{0};
+};
+
+// a queue between two stages, which blocks the producer when full and the consumers when empty, until it is closed.
+template<class T>
+class Channel {
+public:
+    explicit Channel(std::size_t capacity) : _capacity(capacity) {}
+
+    void push(T item) {
+        std::unique_lock lock(_mutex);
+        _not_full.wait(lock, [this] { return _items.size() < _capacity; });
+        _items.push_back(std::move(item));
+        _not_empty.notify_one();
+    }
+
+    std::optional<T> pop() {
+        std::unique_lock lock(_mutex);
+        _not_empty.wait(lock, [this] { return !_items.empty() || _closed; });
+        if (_items.empty())
+            return std::nullopt;
+        T item = std::move(_items.front());
+        _items.pop_front();
+        _not_full.notify_one();
+        return item;
+    }
+
+    void close() {
+        std::lock_guard lock(_mutex);
+        _closed = true;
+        _not_empty.notify_all();
+    }
+
+private:
+    std::size_t _capacity;
+    std::deque<T> _items;
+    bool _closed{false};
+    std::mutex _mutex;
+    std::condition_variable _not_full, _not_empty;
+};
+
+double milliseconds(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+std::vector<Job> read_manifest(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Error: Cannot open manifest " + filename + ".");
+
+    std::vector<Job> jobs;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        Job job;
+        if (!(fields >> job.problem))
+            continue;
+        if (!(fields >> job.input >> job.output))
+            throw std::runtime_error("Error: manifest line '" + line + "' needs a problem, an input and an output.");
+        for (std::string param; fields >> param;) {
+            const std::size_t eq = param.find('=');
+            if (eq == std::string::npos)
+                throw std::runtime_error("Error: manifest parameter '" + param + "' is not <key>=<value>.");
+            job.params[param.substr(0, eq)] = std::stod(param.substr(eq + 1));
+        }
+        job.id = jobs.size();
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+// a positive number of workers, as a whole argument.
+unsigned parse_workers(const std::string &arg) {
+    std::size_t end = 0;
+    unsigned long workers = 0;
+    try {
+        workers = std::stoul(arg, &end);
+    } catch (const std::exception &) {
+        end = 0;
+    }
+    if (end == 0 || end != arg.size() || workers == 0 || workers > std::numeric_limits<unsigned>::max())
+        throw std::runtime_error("Error: workers must be a positive number, not " + arg + ".");
+    return static_cast<unsigned>(workers);
+}
+
+// the configurations of the examples, with their built-in strategies.
+ProblemConfig configure(const Job &job) {
+    auto param = [&job](const std::string &key, double fallback) {
+        auto it = job.params.find(key);
+        return (it == job.params.end()) ? fallback : it->second;
+    };
+    for (const auto &[key, value]: job.params)
+        if (key != "dt" && key != "dwell" && key != "k_best")
+            throw std::runtime_error("Error: unknown parameter " + key + ".");
+
+    ProblemConfig config;
+    config.N = static_cast<int>(job.v_rel.at(0).size());
+    config.k_best = static_cast<int>(param("k_best", 1));
+    if (job.problem == "mwe") {
+        config.v_feasible.assign(config.N, {{0}, {1}});
+        config.strategy = ProblemConfig::Strategy::SimpleRounding;
+        config.dt = param("dt", 1.0);
+    } else if (job.problem == "trj") {
+        const double dwell = param("dwell", 0.3);
+        config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+        config.strategy = ProblemConfig::Strategy::SumUp;
+        config.dt = param("dt", 0.02);
+        config.dwell_time_cons = {{{1}, {dwell}}, {{0}, {dwell}}, {{-1}, {dwell}}};
+    } else if (job.problem == "rck" || job.problem == "lvf") {
+        const bool rck = (job.problem == "rck");
+        const double dwell = param("dwell", rck ? 0.01 : 0.2);
+        config.v_feasible.assign(config.N, {{0}, {1}});
+        config.strategy = ProblemConfig::Strategy::SumUp;
+        config.dt = param("dt", rck ? 0.0005 : 12.0 / config.N);
+        if (rck)
+            config.dwell_time_cons = {{{1}, {dwell}}, {{0}, {dwell}}};
+        else
+            config.dwell_time_cons = {{{0}, {dwell}}, {{1}, {dwell}}};
+    } else if (job.problem == "sos") {
+        const double dwell = param("dwell", 0.2);
+        config.v_feasible.assign(config.N, {{1, 0}, {0, 1}});
+        config.strategy = ProblemConfig::Strategy::SumUpInfNorm;
+        config.dt = param("dt", 0.02);
+        config.dwell_time_cons = {{{0}, {dwell, dwell}}, {{1}, {0, 0}}};
+    } else if (job.problem == "mat") {
+        config.v_feasible.assign(config.N, {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+        config.strategy = ProblemConfig::Strategy::CIA;
+        config.dt = param("dt", 1.0);
+        config.dwell_time_cons = {{{1}, {1.5, 0.5, 0.5}}};
+        config.dwell_time_init = {{1.5, 0.5, 0.5}};
+    } else {
+        throw std::runtime_error("Error: unknown problem " + job.problem + ".");
+    }
+    return config;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <manifest> [workers]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    DPapprox::Log.setThreshold(WARNING);
+
+    std::vector<Job> jobs;
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    try {
+        jobs = read_manifest(argv[1]);
+        if (argc > 2)
+            workers = parse_workers(argv[2]);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto start = Clock::now();
+
+    // the reader parses up to two inputs per worker ahead, the writer takes the results in order of completion.
+    Channel<Job> parsed(2 * workers), solved(jobs.size() + 1);
+    std::thread reader([&] {
+        for (Job &job: jobs) {
+            const auto t0 = Clock::now();
+            try {
+                job.v_rel = read_csv(job.input);
+                if (job.v_rel.empty() || job.v_rel[0].empty())
+                    job.error = "Error: Cannot read " + job.input + ".";
+            } catch (const std::exception &e) {
+                job.error = "Error: Cannot parse " + job.input + ": " + e.what();
+            }
+            job.parsed = Clock::now();
+            job.parse_ms = milliseconds(t0, job.parsed);
+            parsed.push(std::move(job));
+        }
+        parsed.close();
+    });
+
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < workers; ++w) {
+        pool.emplace_back([&] {
+            while (std::optional<Job> job = parsed.pop()) {
+                job->started = Clock::now();
+                job->wait_ms = milliseconds(job->parsed, job->started);
+                if (job->error.empty()) {
+                    try {
+                        Solver solver(job->v_rel, configure(*job));
+                        solver.solve();
+                        job->solution = std::move(solver.solution);
+                    } catch (const std::exception &e) {
+                        job->error = e.what();
+                    }
+                }
+                job->solve_ms = milliseconds(job->started, Clock::now());
+                solved.push(std::move(*job));
+            }
+        });
+    }
+
+    int failed = 0;
+    std::thread writer([&] {
+        std::cout << "job problem input parse_ms wait_ms solve_ms write_ms objective success" << std::endl;
+        while (std::optional<Job> job = solved.pop()) {
+            const auto t0 = Clock::now();
+            if (job->error.empty() && !write_csv(job->output, job->solution.optimum_path))
+                job->error = "Error: Cannot write " + job->output + ".";
+            job->write_ms = milliseconds(t0, Clock::now());
+            std::cout << job->id << " " << job->problem << " " << job->input << " " << job->parse_ms << " "
+                      << job->wait_ms << " " << job->solve_ms << " " << job->write_ms << " ";
+            if (job->error.empty()) {
+                std::cout << job->solution.objective << " " << job->solution.success << std::endl;
+            } else {
+                std::cout << "- 0" << std::endl;
+                std::cerr << "Job " << job->id << ": " << job->error << std::endl;
+            }
+            failed += !job->error.empty() || !job->solution.success;
+        }
+    });
+
+    reader.join();
+    for (std::thread &t: pool)
+        t.join();
+    solved.close();
+    writer.join();
+
+    std::cout << "Ran " << jobs.size() << " jobs on " << workers << " workers in "
+              << milliseconds(start, Clock::now()) << " ms. Failed: " << failed << std::endl;
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
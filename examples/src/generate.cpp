@@ -0,0 +1,67 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include "DPapprox.h"
+#include "generator.h"
+
+using namespace DPapprox;
+
+/*
+ * generate <prefix> [key=value ...] : writes the relaxed inputs of a synthetic problem to <prefix>.csv, and its spec to
+ *                                     <prefix>.cfg (see generator.h for the keys).
+ * generate --solve <prefix.cfg>     : generates the problem of a spec again and solves it.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || (std::string(argv[1]) == "--solve" && argc < 3)) {
+        std::cerr << "Usage: " << argv[0] << " <prefix> [key=value ...]" << std::endl;
+        std::cerr << "       " << argv[0] << " --solve <prefix.cfg>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (std::string(argv[1]) == "--solve") {
+            GeneratorSpec spec = read_spec(argv[2]);
+            std::vector<std::vector<double>> v_rel = generate_relaxed(spec);
+            ProblemConfig config = generate_config(spec);
+            Solver solver(v_rel, config);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            solver.solve();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "Final cost: " << solver.solution.objective << std::endl;
+            std::cout << "Success: " << solver.solution.success << std::endl;
+            std::cout << "Elapsed time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                      << " microseconds\n";
+            return 0;
+        }
+
+        GeneratorSpec spec;
+        for (int a = 2; a < argc; ++a) {
+            std::string arg = argv[a];
+            std::size_t eq = arg.find('=');
+            if (eq == std::string::npos)
+                throw std::runtime_error("Error: expected key=value, got " + arg + ".");
+            set_spec(spec, arg.substr(0, eq), arg.substr(eq + 1));
+        }
+        std::string prefix = argv[1];
+        write_csv(prefix + ".csv", generate_relaxed(spec));
+        write_spec(prefix + ".cfg", spec);
+        std::cout << "Wrote " << prefix << ".csv and " << prefix << ".cfg" << std::endl;
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
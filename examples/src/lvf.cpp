@@ -31,7 +31,7 @@ int main(int argc, char* argv[]) {
     config.v_feasible.assign(config.N, {{0}, {1}});
     config.dt = 12.0/config.N;
     config.stage_cost = stage_cost;
-    config.objective = [](const std::vector<double>& x){return std::fabs(x.at(0));};
+    config.objective = ProblemConfig::abs_objective;
     double min_dwell_time = 0.2;
     config.dwell_time_cons = { {{0}, {min_dwell_time}},
                                {{1}, {min_dwell_time}}};
@@ -0,0 +1,68 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "dpapprox_c.h"
+
+/* minimum working example through the C interface, with a SumUp rounding stage cost. */
+
+static int stage_cost(const double *v, const double *r, size_t n_inputs, int i, double dt,
+                      double *out, size_t cost_dim, void *user_data) {
+    out[0] = (v[0] - r[0]) * dt;
+    return 0;
+}
+
+static double objective(const double *cost, size_t cost_dim, void *user_data) {
+    return fabs(cost[0]);
+}
+
+int main(void) {
+    double v_rel[] = {0.2, 0.8, 0.4};
+    double values[] = {0, 1};
+    double path[3];
+    double cost[1];
+
+    dpapprox_problem problem = {0};
+    problem.struct_size = sizeof(problem);
+    problem.N = 3;
+    problem.dt = 1.0;
+    problem.feasible.values = values;
+    problem.feasible.n_inputs = 1;
+    problem.feasible.n_values = 2;
+    problem.cost_dim = 1;
+    problem.stage_cost = stage_cost;
+    problem.objective = objective;
+
+    dpapprox_matrix rel = {v_rel, 1, 3, 3, 1};
+    dpapprox_solver *solver = NULL;
+    if (dpapprox_solver_create(&problem, &rel, &solver) != DPAPPROX_OK ||
+        dpapprox_solver_solve(solver) != DPAPPROX_OK) {
+        fprintf(stderr, "%s\n", dpapprox_last_error());
+        dpapprox_solver_destroy(solver);
+        return 1;
+    }
+
+    dpapprox_result result = {0};
+    result.struct_size = sizeof(result);
+    result.path.data = path;
+    result.path.rows = 1;
+    result.path.cols = 3;
+    result.path.row_stride = 3;
+    result.path.col_stride = 1;
+    result.cost = cost;
+    result.cost_capacity = 1;
+    dpapprox_solver_result(solver, &result);
+    dpapprox_solver_destroy(solver);
+
+    for (int i = 0; i < 3; ++i)
+        printf("%g ", path[i]);
+    printf("\nFinal cost: %g\nSuccess: %d\n", result.objective, result.success);
+    return 0;
+}
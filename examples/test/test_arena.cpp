@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include "DPapprox.h"
+
+namespace ARENA {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    // counts the allocations made through it, and forwards them to the heap.
+    class Counting : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations{0};
+        std::size_t bytes{0};
+    private:
+        void *do_allocate(std::size_t n, std::size_t align) override {
+            ++allocations;
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+        void do_deallocate(void *p, std::size_t n, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST(arena_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, relaxed by the callbacks rather than the min-plus kernel
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = ARENA::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    config.objective_kind = ProblemConfig::ObjectiveKind::Custom;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// The tables keep their capacity between solves, and repeated solves give the same result
+    Solver solver(v_rel, config);
+    solver.solve();
+    Solution first = solver.solution;
+    solver.solve();
+
+// A caller provided resource gives the same result as well
+    std::pmr::monotonic_buffer_resource resource;
+    Solver external(v_rel, config, &resource);
+    external.solve();
+
+// The tables are allocated through the caller's resource, and solving again, or updating, allocates nothing more,
+// with either relaxation
+    ARENA::Counting counting;
+    Solver counted(v_rel, config, &counting);
+    const std::size_t constructed = counting.allocations;
+    counted.solve();
+    EXPECT_GT(counting.allocations, constructed);
+    EXPECT_GT(counting.bytes, 0u);
+    const std::size_t allocations = counting.allocations;
+    counted.solve();
+    EXPECT_EQ(counting.allocations, allocations);
+    counted.update(v_rel, config.N / 2);
+    EXPECT_EQ(counting.allocations, allocations);
+
+    ProblemConfig absolute = config;
+    absolute.objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+    ARENA::Counting kernel_counting;
+    Solver kernel_counted(v_rel, absolute, &kernel_counting);
+    const std::size_t kernel_constructed = kernel_counting.allocations;
+    kernel_counted.solve();
+    EXPECT_GT(kernel_counting.allocations, kernel_constructed);
+    const std::size_t kernel_allocations = kernel_counting.allocations;
+    kernel_counted.solve();
+    kernel_counted.update(v_rel, config.N / 2);
+    EXPECT_EQ(kernel_counting.allocations, kernel_allocations);
+
+// Nor does an arena over it go back upstream
+    ARENA::Counting upstream;
+    std::pmr::monotonic_buffer_resource arena(&upstream);
+    Solver arena_solver(v_rel, config, &arena);
+    arena_solver.solve();
+    EXPECT_GT(upstream.allocations, 0u);
+    const std::size_t upstream_allocations = upstream.allocations;
+    arena_solver.solve();
+    arena_solver.update(v_rel, config.N / 2);
+    EXPECT_EQ(upstream.allocations, upstream_allocations);
+
+// The generic relaxation agrees with the min-plus kernel
+    config.objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+    Solver kernel(v_rel, config);
+    kernel.solve();
+
+    ASSERT_TRUE(first.success);
+    for (const Solution *s: {&solver.solution, &external.solution, &counted.solution, &arena_solver.solution,
+                             &kernel.solution}) {
+        EXPECT_EQ(s->optimum_path, first.optimum_path);
+        EXPECT_DOUBLE_EQ(s->objective, first.objective);
+    }
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "DPapprox.h"
+
+namespace BACK_POINTERS {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(back_pointers_test, round_trip) {
+    using namespace DPapprox;
+// Nodes of varied sizes, so that the entries straddle the word boundaries
+    std::vector<std::size_t> sizes{1, 3, 5, 2, 1, 17, 64, 65, 1000, 7, 33};
+    std::vector<std::size_t> offset{0};
+    for (auto n: sizes)
+        offset.push_back(offset.back() + n);
+
+    std::mt19937 gen(3);
+    for (std::size_t budget: {std::size_t{0}, std::size_t{1}}) {
+        BackPointers path;
+        path.reset(offset, budget);
+        EXPECT_EQ(path.spilled(), budget != 0);
+        std::vector<std::vector<std::uint32_t>> expected(sizes.size());
+        for (std::size_t i = 1; i < sizes.size(); ++i) {
+            std::uniform_int_distribution<std::uint32_t> pred(0, sizes[i - 1] - 1);
+            for (std::size_t j = 0; j < sizes[i]; ++j) {
+                expected[i].push_back(pred(gen));
+                path.set(static_cast<int>(i), j, expected[i].back());
+            }
+        }
+        for (std::size_t i = 1; i < sizes.size(); ++i)
+            for (std::size_t j = 0; j < sizes[i]; ++j)
+                EXPECT_EQ(path.get(static_cast<int>(i), j), expected[i][j]);
+        EXPECT_LT(path.bytes(), (offset.back() - sizes[0]) * sizeof(std::int32_t));
+    }
+}
+
+TEST(back_pointers_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = BACK_POINTERS::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// A budget of one byte spills the back pointers to a file, which gives the same solution
+    config.path_budget = 1;
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    EXPECT_EQ(solver.solution.optimum_path, v_sol);
+
+// Also when the solver is reused
+    solver.update(v_rel, 250);
+    EXPECT_EQ(solver.solution.optimum_path, v_sol);
+}
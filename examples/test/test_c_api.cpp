@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "DPapprox.h"
+#include "dpapprox_c.h"
+
+namespace C_API {
+    int stage_cost(const double *v, const double *r, size_t, int, double dt, double *out, size_t, void *) {
+        out[0] = (v[0] - r[0]) * dt;
+        return 0;
+    }
+
+    int blocked_cost(const double *v, const double *r, size_t n, int i, double dt, double *out, size_t dim,
+                     void *user_data) {
+        if (i >= 100) {
+            out[0] = DPapprox::INFTY[0];
+            return 0;
+        }
+        return stage_cost(v, r, n, i, dt, out, dim, user_data);
+    }
+
+    double objective(const double *cost, size_t, void *) {
+        return std::fabs(cost[0]);
+    }
+}
+
+TEST(c_api_test, trj) {
+    using namespace DPapprox;
+// Load data, stored with a column stride of 2 to check that strides are honored
+    std::vector<std::vector<double>> data = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+    const int N = 500;
+    std::vector<double> v_rel(2 * N, -1.0);
+    for (int i = 0; i < N; ++i)
+        v_rel[2 * i] = data[0][i];
+
+// Define Problem
+    double values[] = {1, 0, -1};
+    int seq_1[] = {1}, seq_0[] = {0}, seq_m1[] = {-1};
+    double min_dwell_time[] = {0.3};
+    dpapprox_dwell dwell[] = {{seq_1, 1, min_dwell_time, nullptr},
+                              {seq_0, 1, min_dwell_time, nullptr},
+                              {seq_m1, 1, min_dwell_time, nullptr}};
+
+    dpapprox_problem problem{};
+    problem.struct_size = sizeof(problem);
+    problem.N = N;
+    problem.dt = 0.02;
+    problem.feasible = {values, 1, 3, nullptr};
+    problem.dwell = dwell;
+    problem.n_dwell = 3;
+    problem.cost_dim = 1;
+    problem.stage_cost = C_API::stage_cost;
+    problem.objective = C_API::objective;
+
+    dpapprox_matrix rel{v_rel.data(), 1, static_cast<size_t>(N), 0, 2};
+    dpapprox_solver *solver = nullptr;
+    ASSERT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_OK) << dpapprox_last_error();
+    ASSERT_EQ(dpapprox_solver_solve(solver), DPAPPROX_OK) << dpapprox_last_error();
+
+    std::vector<double> path(N);
+    double cost[1];
+    dpapprox_result result{};
+    result.struct_size = sizeof(result);
+    result.path = {path.data(), 1, static_cast<size_t>(N), static_cast<ptrdiff_t>(N), 1};
+    result.cost = cost;
+    result.cost_capacity = 1;
+    ASSERT_EQ(dpapprox_solver_result(solver, &result), DPAPPROX_OK) << dpapprox_last_error();
+    dpapprox_solver_destroy(solver);
+
+// Compare Results
+    EXPECT_EQ(result.success, 1);
+    EXPECT_EQ(result.status, DPAPPROX_SOLVED);
+    EXPECT_EQ(result.last_node, N - 1);
+    EXPECT_EQ(result.cost_dim, 1u);
+    for (int i = 0; i < N; ++i)
+        EXPECT_DOUBLE_EQ(path[i], v_sol[i][0]);
+
+// A stage where every label hits INFTY ends the DP there, and the status says so
+    problem.stage_cost = C_API::blocked_cost;
+    ASSERT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_OK) << dpapprox_last_error();
+    ASSERT_EQ(dpapprox_solver_solve(solver), DPAPPROX_OK) << dpapprox_last_error();
+    dpapprox_result blocked = result;
+    ASSERT_EQ(dpapprox_solver_result(solver, &blocked), DPAPPROX_OK) << dpapprox_last_error();
+    dpapprox_solver_destroy(solver);
+    EXPECT_EQ(blocked.success, 0);
+    EXPECT_EQ(blocked.status, DPAPPROX_INFEASIBLE);
+    EXPECT_EQ(blocked.last_node, 100);
+    problem.stage_cost = C_API::stage_cost;
+
+// Invalid feasible sets and relaxed solutions are rejected
+    size_t offsets[N + 1];
+    for (int i = 0; i <= N; ++i)
+        offsets[i] = 0;
+    offsets[N] = 3;
+    problem.feasible.node_offsets = offsets;
+    EXPECT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_ERROR_ARGUMENT);
+    for (int i = 0; i <= N; ++i)
+        offsets[i] = 3 * i;
+    problem.feasible.node_offsets = offsets;
+    EXPECT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_ERROR_ARGUMENT);
+    problem.feasible.node_offsets = nullptr;
+    rel.rows = 2;
+    EXPECT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_ERROR_ARGUMENT);
+    rel.rows = 1;
+
+// A caller built against a header without the trailing fields gets their defaults
+    problem.struct_size = offsetof(dpapprox_problem, engine);
+    problem.engine = static_cast<dpapprox_engine>(7);
+    ASSERT_EQ(dpapprox_solver_create(&problem, &rel, &solver), DPAPPROX_OK) << dpapprox_last_error();
+    ASSERT_EQ(dpapprox_solver_solve(solver), DPAPPROX_OK) << dpapprox_last_error();
+    dpapprox_result older{};
+    older.struct_size = offsetof(dpapprox_result, cost_dim);
+    older.path = result.path;
+    older.cost = cost;
+    older.cost_capacity = 1;
+    older.success = 7;
+    older.last_node = 7;
+    ASSERT_EQ(dpapprox_solver_result(solver, &older), DPAPPROX_OK) << dpapprox_last_error();
+    dpapprox_solver_destroy(solver);
+    EXPECT_EQ(older.success, 7);
+    EXPECT_EQ(older.last_node, 7);
+    for (int i = 0; i < N; ++i)
+        EXPECT_DOUBLE_EQ(path[i], v_sol[i][0]);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+#include "test_utils.h"
+
+namespace COARSEN {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(coarsen_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = COARSEN::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// Merging only identical columns keeps the solution of trj
+    config.coarsen_tolerance = 0;
+    Solver exact(v_rel, config);
+    exact.solve();
+    ASSERT_TRUE(exact.solution.success);
+    EXPECT_EQ(exact.solution.optimum_path, v_sol);
+
+// A wider tolerance gives a full path that keeps the minimum dwell time of 15 nodes
+    config.coarsen_tolerance = 0.01;
+    Solver coarse(v_rel, config);
+    coarse.solve();
+    ASSERT_TRUE(coarse.solution.success);
+    ASSERT_EQ(coarse.solution.optimum_path.size(), static_cast<size_t>(config.N));
+    EXPECT_EQ(coarse.solution.last_node, config.N - 1);
+    EXPECT_NEAR(coarse.solution.objective, 0.0047932, 1e-6);
+
+    TEST_UTILS::expect_dwell(coarse.solution.optimum_path, 15);
+
+// States are not supported
+    config.include_state = true;
+    config.x0 = {0};
+    Solver states(v_rel, config);
+    EXPECT_THROW(states.solve(), std::runtime_error);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "DPapprox.h"
+#include "generator.h"
+#include "test_utils.h"
+
+TEST(generator_test, reproducible) {
+    using namespace DPapprox;
+    GeneratorSpec spec;
+    spec.N = 2000;
+    spec.nv = 2;
+    spec.levels = 3;
+    spec.chattering = 0.3;
+    spec.seed = 7;
+
+// The same seed gives the same inputs, another seed other inputs, all within the levels
+    std::vector<std::vector<double>> v_rel = generate_relaxed(spec);
+    ASSERT_EQ(v_rel.size(), 2u);
+    ASSERT_EQ(v_rel[0].size(), 2000u);
+    EXPECT_EQ(generate_relaxed(spec), v_rel);
+    for (const std::vector<double> &row: v_rel)
+        for (double r: row) {
+            EXPECT_GE(r, 0.0);
+            EXPECT_LE(r, 2.0);
+        }
+    spec.seed = 8;
+    EXPECT_NE(generate_relaxed(spec), v_rel);
+
+// A spec is written and read back unchanged
+    spec.min_dwell_time = 0.05;
+    spec.state = true;
+    const std::string filename = "test_generator.cfg";
+    write_spec(filename, spec);
+    GeneratorSpec loaded = read_spec(filename);
+    std::remove(filename.c_str());
+    EXPECT_EQ(loaded.N, spec.N);
+    EXPECT_EQ(loaded.nv, spec.nv);
+    EXPECT_EQ(loaded.seed, spec.seed);
+    EXPECT_EQ(loaded.state, spec.state);
+    EXPECT_DOUBLE_EQ(loaded.chattering, spec.chattering);
+    EXPECT_DOUBLE_EQ(loaded.min_dwell_time, spec.min_dwell_time);
+    EXPECT_THROW(set_spec(loaded, "unknown", "1"), std::runtime_error);
+}
+
+TEST(generator_test, solve) {
+    using namespace DPapprox;
+    GeneratorSpec spec;
+    spec.N = 3000;
+    spec.levels = 4;
+    spec.chattering = 0.5;
+    spec.min_dwell_time = 0.1;
+    spec.seed = 1;
+
+// The generated problem is solved, and keeps the dwell time of 10 nodes
+    ProblemConfig config = generate_config(spec);
+    ASSERT_EQ(config.v_feasible[0].size(), 4u);
+    Solver solver(generate_relaxed(spec), config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    ASSERT_EQ(solver.solution.optimum_path.size(), 3000u);
+    TEST_UTILS::expect_dwell(solver.solution.optimum_path, 10);
+
+// With the lagged state, its bound holds along the trajectory
+    spec.state = true;
+    spec.state_bound = 2.0;
+    spec.N = 1000;
+    config = generate_config(spec);
+    Solver state_solver(generate_relaxed(spec), config);
+    state_solver.solve();
+    ASSERT_TRUE(state_solver.solution.success);
+    double x = 0;
+    for (const ProblemConfig::disc_vector &v: state_solver.solution.optimum_path) {
+        x += (v[0] - x) * (spec.dt / spec.tau);
+        EXPECT_LE(x, spec.state_bound + 1e-9);
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace INTERRUPT {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    // every value violates a state constraint from node 100 on.
+    std::vector<double> blocked_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        if (i >= 100)
+            return INFTY;
+        return {(vi - ri) * dt};
+    }
+
+    ProblemConfig trj() {
+        ProblemConfig config;
+        config.N = 500;
+        config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+        config.dt = 0.02;
+        config.stage_cost = stage_cost;
+        config.objective = ProblemConfig::abs_objective;
+        double min_dwell_time = 0.3;
+        config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                                   {{0}, {min_dwell_time}},
+                                   {{-1}, {min_dwell_time}}};
+        return config;
+    }
+}
+
+TEST(interrupt_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+    for (auto engine: {ProblemConfig::Engine::Labels, ProblemConfig::Engine::StateGraph}) {
+        ProblemConfig config = INTERRUPT::trj();
+        config.engine = engine;
+
+// An asynchronous solve gives the result of a blocking one
+        Solver blocking(v_rel, config);
+        blocking.solve();
+        Solver solver(v_rel, config);
+        Solution async = solver.solve_async().get();
+        EXPECT_EQ(async.status, Solution::Status::Solved);
+        EXPECT_EQ(async.last_node, config.N - 1);
+        EXPECT_EQ(async.optimum_path, blocking.solution.optimum_path);
+
+// A cancelled solve stops at the first stage, and returns a flagged greedy rounding
+        config.cancel = std::make_shared<std::atomic<bool>>(true);
+        Solver cancelled(v_rel, config);
+        cancelled.solve();
+        EXPECT_EQ(cancelled.solution.status, Solution::Status::Cancelled);
+        EXPECT_EQ(cancelled.solution.last_node, 0);
+        EXPECT_FALSE(cancelled.solution.success);
+        ASSERT_EQ(cancelled.solution.optimum_path.size(), static_cast<size_t>(config.N));
+        for (int i = 0; i < config.N; ++i)
+            EXPECT_DOUBLE_EQ(cancelled.solution.optimum_path[i][0], std::round(v_rel[0][i]));
+
+// A deadline in the past stops the solve as well
+        config.cancel = nullptr;
+        config.deadline = std::chrono::steady_clock::now();
+        Solver late(v_rel, config);
+        EXPECT_EQ(late.solve_async().get().status, Solution::Status::Deadline);
+
+// A stage where every label hits INFTY ends the DP there
+        config.deadline = std::chrono::steady_clock::time_point::max();
+        config.stage_cost = INTERRUPT::blocked_cost;
+        Solver blocked(v_rel, config);
+        blocked.solve();
+        EXPECT_EQ(blocked.solution.status, Solution::Status::Infeasible);
+        EXPECT_EQ(blocked.solution.last_node, 100);
+        EXPECT_FALSE(blocked.solution.success);
+        EXPECT_EQ(blocked.solution.optimum_path.size(), static_cast<size_t>(config.N));
+    }
+}
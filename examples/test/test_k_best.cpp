@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "DPapprox.h"
+#include "test_utils.h"
+
+namespace K_BEST {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(k_best_test, brute_force) {
+    using namespace DPapprox;
+// A short problem without dwell time constraints, where the costs add up and all paths can be enumerated
+    const int N = 8;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<std::vector<double>> v_rel(1, std::vector<double>(N));
+    for (auto &r: v_rel[0]) r = unit(gen);
+
+    ProblemConfig config;
+    config.N = N;
+    config.v_feasible.assign(N, {{0}, {1}});
+    config.k_best = 5;
+
+    std::vector<double> costs;
+    for (int mask = 0; mask < (1 << N); ++mask) {
+        double cost = 0;
+        for (int i = 0; i < N; ++i)
+            cost += std::abs(((mask >> i) & 1) - v_rel[0][i]);
+        costs.push_back(cost);
+    }
+    std::sort(costs.begin(), costs.end());
+
+// The ranked paths are the five best ones, distinct, with their cost and objective
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_EQ(solver.solutions.size(), 5u);
+    EXPECT_EQ(solver.solutions[0].optimum_path, solver.solution.optimum_path);
+    for (std::size_t r = 0; r < 5; ++r) {
+        const Solution &s = solver.solutions[r];
+        double cost = 0;
+        for (int i = 0; i < N; ++i)
+            cost += std::abs(s.optimum_path[i][0] - v_rel[0][i]);
+        EXPECT_NEAR(s.objective, costs[r], 1e-12);
+        EXPECT_NEAR(s.cost[0], cost, 1e-12);
+        for (std::size_t q = 0; q < r; ++q)
+            EXPECT_NE(s.optimum_path, solver.solutions[q].optimum_path);
+    }
+}
+
+TEST(k_best_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = K_BEST::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// One rank keeps the solution, without ranked paths
+    Solver single(v_rel, config);
+    single.solve();
+    EXPECT_TRUE(single.solutions.empty());
+    EXPECT_EQ(single.solution.optimum_path, v_sol);
+
+// Four ranks give four distinct paths in ranked order, whose objective is their replayed cost, and which keep the
+// dwell times. The tables do not grow with the ranks
+    const Plan plan = Solver::plan(config, 1, config.N);
+    config.k_best = 4;
+    EXPECT_EQ(Solver::plan(config, 1, config.N).labels, plan.labels);
+    EXPECT_EQ(Solver::plan(config, 1, config.N).transitions, plan.transitions);
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    ASSERT_EQ(solver.solutions.size(), 4u);
+    EXPECT_LE(solver.solution.objective, single.solution.objective);
+    for (std::size_t r = 0; r < solver.solutions.size(); ++r) {
+        const Solution &s = solver.solutions[r];
+        ASSERT_EQ(s.optimum_path.size(), v_sol.size());
+        double cost = 0;
+        for (int i = 0; i < config.N; ++i)
+            cost += (s.optimum_path[i][0] - v_rel[0][i]) * config.dt;
+        EXPECT_NEAR(s.objective, std::abs(cost), 1e-9);
+        TEST_UTILS::expect_dwell(s.optimum_path, 15);
+        if (r > 0) {
+            EXPECT_LE(solver.solutions[r - 1].objective, s.objective);
+        }
+        for (std::size_t q = 0; q < r; ++q)
+            EXPECT_NE(s.optimum_path, solver.solutions[q].optimum_path);
+    }
+}
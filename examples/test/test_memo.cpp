@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace MEMO {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    std::vector<double> state_cost(const ProblemConfig::traj_vector &x, const std::vector<double> &, int, double) {
+        return {x[0] > 0.8 ? 1e20 : 0.0};
+    }
+}
+
+TEST(memo_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, with a state constraint on a lag of the input, and count the integrations
+    auto calls = std::make_shared<std::size_t>(0);
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = MEMO::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    config.include_state = true;
+    config.x0 = {0};
+    config.state_transition = [calls](const ProblemConfig::traj_vector &x, const ProblemConfig::disc_vector &vi,
+                                      int, double dt) {
+        ++*calls;
+        return ProblemConfig::traj_vector{x[0] + (vi[0] - x[0]) * dt / 0.1};
+    };
+    config.state_cost = MEMO::state_cost;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+    Solver reference(v_rel, config);
+    reference.solve();
+    EXPECT_EQ(reference.memo_stats().hits + reference.memo_stats().misses, 0u);
+
+// The cache of exact states gives the same solution
+    config.memo_capacity = 1 << 16;
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    EXPECT_EQ(solver.solution.optimum_path, reference.solution.optimum_path);
+    EXPECT_EQ(solver.solution.optimum_traj, reference.solution.optimum_traj);
+    EXPECT_DOUBLE_EQ(solver.solution.objective, reference.solution.objective);
+
+// Solving again looks every transition up
+    const MemoStats first = solver.memo_stats();
+    EXPECT_GT(first.misses, 0u);
+    EXPECT_EQ(first.evictions, 0u);
+    const std::size_t integrations = *calls;
+    solver.reset(v_rel);
+    solver.solve();
+    EXPECT_EQ(*calls, integrations);
+    EXPECT_GT(solver.memo_stats().hits, first.hits);
+    EXPECT_EQ(solver.solution.optimum_path, reference.solution.optimum_path);
+
+// States quantized on a fine grid key the same transitions
+    config.memo_quantum = 1e-9;
+    Solver quantized(v_rel, config);
+    quantized.solve();
+    quantized.reset(v_rel);
+    quantized.solve();
+    EXPECT_EQ(quantized.solution.optimum_path, reference.solution.optimum_path);
+    EXPECT_EQ(quantized.memo_stats().hits, solver.memo_stats().hits);
+    EXPECT_EQ(quantized.memo_stats().misses, solver.memo_stats().misses);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "DPapprox.h"
+
+TEST(min_plus_test, isa_agree) {
+    using namespace DPapprox::kernels;
+// Random stage with ties and infeasible transitions
+    const size_t n = 37, m = 19;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> level(-4, 4);
+    std::vector<double> V(n), c(m), pen(n * m);
+    for (auto &x: V) x = 0.25 * level(gen);
+    for (auto &x: c) x = 0.25 * level(gen);
+    for (auto &x: pen) x = (level(gen) > 2) ? 1e20 : 0.0;
+
+    for (MinPlusOp op: {MinPlusOp::Identity, MinPlusOp::Absolute}) {
+        std::vector<double> cost_ref(m), cost(m);
+        std::vector<size_t> arg_ref(m), arg(m);
+        min_plus(V.data(), n, c.data(), pen.data(), m, op, cost_ref.data(), arg_ref.data(), MinPlusIsa::Scalar);
+        for (MinPlusIsa isa: {MinPlusIsa::AVX2, MinPlusIsa::AVX512}) {
+            min_plus(V.data(), n, c.data(), pen.data(), m, op, cost.data(), arg.data(), isa);
+            for (size_t j = 0; j < m; ++j) {
+                EXPECT_EQ(arg[j], arg_ref[j]);
+                EXPECT_DOUBLE_EQ(cost[j], cost_ref[j]);
+            }
+        }
+    }
+}
+
+TEST(min_plus_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+
+// Define Problem with an objective declared as the absolute value of the cost
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = [](const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int, double dt) {
+        return std::vector<double>{(vi[0] - ri[0]) * dt};
+    };
+    config.objective = [](const std::vector<double> &x) { return std::abs(x[0]); };
+    config.objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    EXPECT_EQ(Solver::plan(config, 1, 500).mode, Plan::Mode::MinPlus);
+    Solver solver(v_rel, config);
+    solver.solve();
+
+// Compare Results
+    ASSERT_EQ(solver.solution.optimum_path.size(), v_sol.size());
+    for (size_t i = 0; i < v_sol.size(); ++i)
+        EXPECT_DOUBLE_EQ(solver.solution.optimum_path[i][0], v_sol[i][0]);
+
+// The kernel is off unless the objective is declared, or is one of the built-in functions
+    config.objective_kind = ProblemConfig::ObjectiveKind::Auto;
+    EXPECT_EQ(Solver::plan(config, 1, 500).mode, Plan::Mode::Labels);
+    config.objective = ProblemConfig::abs_objective;
+    EXPECT_EQ(Solver::plan(config, 1, 500).mode, Plan::Mode::MinPlus);
+    config.objective = ProblemConfig::default_objective;
+    EXPECT_EQ(Solver::plan(config, 1, 500).mode, Plan::Mode::MinPlus);
+    config.objective_kind = ProblemConfig::ObjectiveKind::Custom;
+    EXPECT_EQ(Solver::plan(config, 1, 500).mode, Plan::Mode::Labels);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+#include "test_utils.h"
+
+namespace MULTIRES {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    // only -1 is feasible at node 25, where the coarse path stays at 1.
+    std::vector<double> pinned_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        if (i == 25 && vi[0] != -1)
+            return INFTY;
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(multires_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, solved on a grid of 50 nodes first
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = MULTIRES::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    config.multires_factor = 10;
+    config.corridor = 1;
+
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    ASSERT_EQ(solver.solution.optimum_path.size(), static_cast<size_t>(config.N));
+    EXPECT_NEAR(solver.solution.objective, 0.0152068, 1e-6);
+
+// No value is left before its minimum dwell time of 15 nodes, except the first one
+    TEST_UTILS::expect_dwell(solver.solution.optimum_path, 15);
+
+// The corridor is widened where the fine solve hits INFTY
+    config.stage_cost = MULTIRES::pinned_cost;
+    Solver pinned(v_rel, config);
+    pinned.solve();
+    ASSERT_TRUE(pinned.solution.success);
+    EXPECT_EQ(pinned.solution.optimum_path[25], ProblemConfig::disc_vector{-1});
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "DPapprox.h"
+#include "perf_counters.h"
+
+TEST(perf_counters_test, phases) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, recording the phases of the solve
+    std::vector<std::pair<ProblemConfig::Phase, bool>> phases;
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.strategy = ProblemConfig::Strategy::SumUp;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    config.phase_callback = [&](ProblemConfig::Phase phase, bool enter) { phases.emplace_back(phase, enter); };
+
+    PerfCounters counters;
+    const PerfSample start = counters.read();
+    Solver solver(v_rel, config);
+    solver.solve();
+    const PerfSample sample = counters.since(start);
+    ASSERT_TRUE(solver.solution.success);
+
+// The phases are entered and left in order, once each
+    using Phase = ProblemConfig::Phase;
+    std::vector<std::pair<Phase, bool>> expected = {{Phase::Setup, true}, {Phase::Setup, false},
+                                                    {Phase::Relax, true}, {Phase::Relax, false},
+                                                    {Phase::Backtrack, true}, {Phase::Backtrack, false}};
+    EXPECT_EQ(phases, expected);
+
+// Only the events that could be opened count, and an interval counts no more than the whole
+    const PerfSample whole = counters.read();
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e) {
+        EXPECT_EQ(sample.valid[e], start.valid[e]);
+        EXPECT_LE(sample.count[e], whole.count[e]);
+        if (!sample.valid[e]) {
+            EXPECT_EQ(sample.count[e], 0u);
+        }
+    }
+    EXPECT_STREQ(PerfSample::name(PerfSample::Cycles), "cycles");
+    EXPECT_STREQ(PerfSample::name(PerfSample::PageFaults), "page_faults");
+
+// The sum of samples keeps the events valid in either
+    PerfSample sum;
+    sum += sample;
+    sum += sample;
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e) {
+        EXPECT_EQ(sum.valid[e], sample.valid[e]);
+        EXPECT_EQ(sum.count[e], 2 * sample.count[e]);
+    }
+
+// The work of a thread started after the counters were opened is counted once it is joined
+    const PerfSample before = counters.read();
+    std::thread worker([] {
+        std::vector<char> pages(8 << 20);
+        for (std::size_t k = 0; k < pages.size(); k += 4096)
+            pages[k] = 1;
+        EXPECT_EQ(pages[0], 1);
+    });
+    worker.join();
+    const PerfSample joined = counters.since(before);
+    if (joined.valid[PerfSample::PageFaults]) {
+        EXPECT_GT(joined.count[PerfSample::PageFaults], 0u);
+    }
+}
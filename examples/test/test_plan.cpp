@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include "DPapprox.h"
+
+namespace PLAN {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    // counts the bytes taken from the heap by the tables of a Solver.
+    class Counting : public std::pmr::memory_resource {
+    public:
+        std::size_t bytes{0};
+    private:
+        void *do_allocate(std::size_t n, std::size_t align) override {
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+        void do_deallocate(void *p, std::size_t n, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST(plan_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = PLAN::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    config.objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    EXPECT_THROW(Solver::plan(config, 1, 400), std::runtime_error);
+
+// The min-plus kernel relaxes every pair of values, and the prediction covers the tables the solver allocates
+    Plan plan = Solver::plan(config, 1, 500);
+    EXPECT_EQ(plan.mode, Plan::Mode::MinPlus);
+    EXPECT_EQ(plan.labels, 1500u);
+    EXPECT_EQ(plan.transitions, 499u * 9);
+    EXPECT_FALSE(plan.path_spilled);
+    EXPECT_LT(plan.path_bytes, plan.labels * sizeof(std::int32_t));
+
+    PLAN::Counting counting;
+    Solver solver(v_rel, config, &counting);
+    solver.solve();
+    const std::size_t predicted = plan.table_bytes + plan.path_bytes + plan.workspace_bytes;
+    EXPECT_LE(counting.bytes, predicted);
+    EXPECT_GE(counting.bytes, plan.table_bytes);
+    EXPECT_GE(plan.peak_bytes, predicted);
+
+// Ranked paths are enumerated from the tables of one label per value, and a budget spills the back pointers
+    config.objective_kind = ProblemConfig::ObjectiveKind::Custom;
+    config.k_best = 3;
+    config.path_budget = 1;
+    plan = Solver::plan(config, 1, 500);
+    EXPECT_EQ(plan.mode, Plan::Mode::Labels);
+    EXPECT_EQ(plan.labels, 1500u);
+    EXPECT_EQ(plan.transitions, 499u * 9);
+    EXPECT_TRUE(plan.path_spilled);
+
+// Allowed transitions are counted
+    config.k_best = 1;
+    config.allowed_transition = [](const ProblemConfig::disc_vector &a, const ProblemConfig::disc_vector &b) {
+        return std::abs(a[0] - b[0]) < 1.5;
+    };
+    EXPECT_EQ(Solver::plan(config, 1, 500).transitions, 499u * 7);
+    config.allowed_transition = {};
+
+// The state graph has a label per state and node
+    config.engine = ProblemConfig::Engine::StateGraph;
+    plan = Solver::plan(config, 1, 500);
+    EXPECT_EQ(plan.mode, Plan::Mode::StateGraph);
+    EXPECT_EQ(plan.labels % 500, 0u);
+    EXPECT_GT(plan.labels, 1500u);
+    config.engine = ProblemConfig::Engine::Labels;
+
+// A separable problem is planned per dimension
+    std::vector<ProblemConfig::disc_vector> product;
+    for (double a: {1.0, 0.0, -1.0})
+        for (double b: {1.0, 0.0, -1.0})
+            product.push_back({a, b});
+    config.v_feasible.assign(config.N, product);
+    for (auto &con: config.dwell_time_cons)
+        con.second = {min_dwell_time, min_dwell_time};
+    config.separable = true;
+    plan = Solver::plan(config, 2, 500);
+    EXPECT_EQ(plan.mode, Plan::Mode::Separable);
+    EXPECT_EQ(plan.labels, 2u * 1500);
+    EXPECT_EQ(plan.transitions, 2u * 499 * 9);
+
+// Coarse-to-fine solves add their inner solvers
+    config.separable = false;
+    EXPECT_EQ(Solver::plan(config, 2, 500).labels, 9u * 500);
+    config.multires_factor = 10;
+    plan = Solver::plan(config, 2, 500);
+    EXPECT_EQ(plan.mode, Plan::Mode::Multiresolution);
+    EXPECT_EQ(plan.labels, 9u * 50 + 9u * 500);
+}
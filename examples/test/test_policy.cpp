@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "DPapprox.h"
+#include "test_utils.h"
+
+namespace POLICY {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        double d = (vi - ri)[0];
+        return {d * d * dt};
+    }
+}
+
+TEST(policy_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = POLICY::stage_cost;
+    config.engine = ProblemConfig::Engine::StateGraph;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+
+    Policy policy = solver.policy();
+    ASSERT_EQ(policy.N(), config.N);
+    ASSERT_GE(policy.start(), 0);
+
+// Following the policy from its start gives the optimum of the forward DP, and the cost to go adds up along it
+    auto stage = [&](int i, std::int32_t t) {
+        return POLICY::stage_cost(policy.value(policy.state_value(t)), {v_rel[0][i]}, i, config.dt)[0];
+    };
+    std::vector<int> path;
+    double cost = 0;
+    std::int32_t s = policy.start();
+    for (int i = 0; i < config.N; ++i) {
+        ASSERT_GE(s, 0);
+        path.push_back(static_cast<int>(policy.value(policy.state_value(s))[0]));
+        cost += stage(i, s);
+        const std::int32_t t = policy.next(i, s);
+        if (t >= 0) {
+            EXPECT_NEAR(policy.cost_to_go(i, s), stage(i + 1, t) + policy.cost_to_go(i + 1, t), 1e-12);
+        }
+        s = t;
+    }
+    EXPECT_EQ(s, -1);
+    EXPECT_NEAR(cost, solver.solution.objective, 1e-9);
+    EXPECT_NEAR(stage(0, policy.start()) + policy.cost_to_go(0, policy.start()), solver.solution.objective, 1e-9);
+
+// No value is left before its minimum dwell time of 15 nodes, except the first one
+    TEST_UTILS::expect_dwell(path, 15);
+
+// Every state at node 100, on the optimum path or not, e.g. after a disturbance, moves to the successor of least
+// remaining cost. Its successors follow the dwell rules of the problem: the timers count down, a value may not be left
+// while its own timer runs, and entering a value starts its timer.
+    const std::size_t slots = policy.slots();
+    std::vector<int> fresh(slots, 0);
+    for (std::int32_t d = 0; d < static_cast<std::int32_t>(policy.n_states()); ++d)
+        for (std::size_t k = 0; k < slots; ++k)
+            fresh[k] = std::max(fresh[k], static_cast<int>(policy.state_steps(d)[k]));
+    auto slot = [&](std::size_t u) { return static_cast<std::size_t>(1 - policy.value(u)[0]); };
+    for (std::int32_t d = 0; d < static_cast<std::int32_t>(policy.n_states()); ++d) {
+        const std::size_t u = policy.state_value(d);
+        const std::int32_t *steps = policy.state_steps(d);
+        EXPECT_EQ(policy.state(u, steps), d);
+        const std::int32_t t = policy.next(100, d);
+        ASSERT_GE(t, 0) << "state " << d;
+        const double best = stage(101, t) + policy.cost_to_go(101, t);
+        EXPECT_NEAR(policy.cost_to_go(100, d), best, 1e-12);
+        for (std::size_t w = 0; w < policy.n_values(); ++w) {
+            if (w != u && steps[slot(u)] > 0)
+                continue;
+            std::vector<int> next(slots);
+            for (std::size_t k = 0; k < slots; ++k)
+                next[k] = std::max(steps[k] - 1, 0);
+            if (w != u)
+                next[slot(w)] = fresh[slot(w)];
+            const std::int32_t successor = policy.state(w, next.data());
+            ASSERT_GE(successor, 0);
+            EXPECT_LE(best, stage(101, successor) + policy.cost_to_go(101, successor) + 1e-12);
+        }
+    }
+
+// The saved image is mapped back with identical lookups
+    const std::string filename = "test_policy.bin";
+    policy.save(filename);
+    {
+        Policy loaded = Policy::load(filename);
+        ASSERT_EQ(loaded.n_states(), policy.n_states());
+        EXPECT_EQ(loaded.start(), policy.start());
+        for (int i = 0; i < config.N; ++i)
+            for (std::int32_t t = 0; t < static_cast<std::int32_t>(policy.n_states()); ++t) {
+                EXPECT_EQ(loaded.next(i, t), policy.next(i, t));
+                EXPECT_EQ(loaded.cost_to_go(i, t), policy.cost_to_go(i, t));
+            }
+    }
+
+// A truncated or corrupt image is rejected
+    std::vector<char> image;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto write = [&](std::size_t size) {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(image.data(), static_cast<std::streamsize>(size));
+    };
+    write(image.size() / 2);
+    EXPECT_THROW(Policy::load(filename), std::runtime_error);
+    PolicyHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    header.n_states *= 1000;
+    std::memcpy(image.data(), &header, sizeof(header));
+    write(image.size());
+    EXPECT_THROW(Policy::load(filename), std::runtime_error);
+    std::remove(filename.c_str());
+}
+
+TEST(policy_test, rck) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/rck.csv");
+
+// Define Problem, with the absolute value of the accumulated deviation (SUR), which is not additive
+    ProblemConfig config;
+    config.N = 1000;
+    config.v_feasible.assign(config.N, {{0}, {1}});
+    config.dt = 0.0005;
+    config.stage_cost = [](const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int, double dt) {
+        return std::vector<double>{(vi[0] - ri[0]) * dt};
+    };
+    config.objective = ProblemConfig::abs_objective;
+    config.engine = ProblemConfig::Engine::StateGraph;
+    double min_dwell_time = 0.01;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}}};
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+
+// The cost to go of a non-additive objective is not a sum of stage costs, so no policy is compiled for it
+    EXPECT_THROW(solver.policy(), std::runtime_error);
+    config.objective = [](const std::vector<double> &x) { return x[0]; };
+    EXPECT_THROW(Solver(v_rel, config).policy(), std::runtime_error);
+
+// Unless the objective is declared additive
+    config.objective_kind = ProblemConfig::ObjectiveKind::Identity;
+    Solver identity(v_rel, config);
+    EXPECT_GE(identity.policy().start(), 0);
+}
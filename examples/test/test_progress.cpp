@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "DPapprox.h"
+
+namespace PROGRESS {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(progress_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, with a callback due at every stage
+    std::vector<int> stages;
+    std::vector<double> elapsed;
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = PROGRESS::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    config.progress_interval = 0;
+    config.progress_callback = [&](int stage, double, double seconds) {
+        stages.push_back(stage);
+        elapsed.push_back(seconds);
+    };
+
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+
+// The stages are reported in order, and the last report is the solution
+    ASSERT_EQ(stages.size(), static_cast<size_t>(config.N + 1));
+    for (size_t k = 1; k < stages.size(); ++k) {
+        EXPECT_EQ(stages[k], static_cast<int>(k) - 1);
+        EXPECT_LE(elapsed[k - 1], elapsed[k]);
+    }
+    const Progress &progress = solver.progress();
+    EXPECT_FALSE(progress.running.load());
+    EXPECT_EQ(progress.stage.load(), config.N - 1);
+    EXPECT_DOUBLE_EQ(progress.objective.load(), solver.solution.objective);
+
+// Another thread polls the counters of a running solve
+    config.progress_callback = {};
+    Solver polled(v_rel, config);
+    auto future = polled.solve_async();
+    int stage = -1;
+    while (future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
+        const int now = polled.progress().stage.load();
+        EXPECT_GE(now, stage);
+        stage = now;
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(future.get().success);
+    EXPECT_EQ(polled.progress().stage.load(), config.N - 1);
+}
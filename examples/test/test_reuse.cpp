@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace REUSE {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(reuse_test, trj) {
+    using namespace DPapprox;
+// Load data, and a second relaxed solution mirrored around zero
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<std::vector<double>> v_mir = v_rel;
+    for (auto &r: v_mir[0])
+        r = -r;
+
+// Define Problem, shared with the Solver
+    auto config = std::make_shared<ProblemConfig>();
+    config->N = 500;
+    config->v_feasible.assign(config->N, {{1}, {0}, {-1}});
+    config->dt = 0.02;
+    config->stage_cost = REUSE::stage_cost;
+    config->objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config->dwell_time_cons = { {{1}, {min_dwell_time}},
+                                {{0}, {min_dwell_time}},
+                                {{-1}, {min_dwell_time}}};
+
+    for (auto engine: {ProblemConfig::Engine::Labels, ProblemConfig::Engine::StateGraph}) {
+        config->engine = engine;
+        Solver fresh(v_mir, *config);
+        fresh.solve();
+
+// One Solver is reset between relaxed solutions, borrowing them through a view
+        Solver solver(RelaxedView(v_rel), config);
+        solver.solve();
+        Solution first = solver.solution;
+        solver.reset(RelaxedView(v_mir));
+        solver.solve();
+        EXPECT_EQ(solver.solution.optimum_path, fresh.solution.optimum_path);
+        EXPECT_DOUBLE_EQ(solver.solution.objective, fresh.solution.objective);
+
+        solver.reset(v_rel);
+        solver.solve();
+        ASSERT_TRUE(solver.solution.success);
+        EXPECT_EQ(solver.solution.optimum_path, first.optimum_path);
+        EXPECT_DOUBLE_EQ(solver.solution.objective, first.objective);
+    }
+}
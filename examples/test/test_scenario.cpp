@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace SCENARIO {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector& vi,
+                                   const std::vector<double>& ri,
+                                   int /*i*/,
+                                   double dt){
+        return {(vi - ri) * dt};
+    }
+
+    // the parameters of the rocket in each scenario, the first one is the nominal model of rck_robust.
+    std::vector<double> A{310, 300, 320};
+    std::vector<double> T_max{3.5, 3.4, 3.6};
+    double k = 500;
+    double r0 = 1;
+    double b = 7;
+    double C = 0.6;
+
+    // the dynamics of all scenarios, on bundles <r, v, m> stored SoA.
+    ProblemConfig::bundle_vector f(const ProblemConfig::bundle_vector &x, double u, std::size_t S) {
+        ProblemConfig::bundle_vector dx(3 * S);
+        for (std::size_t s = 0; s < S; ++s) {
+            double r = x[s], v = x[S + s], m = x[2 * S + s];
+            dx[s] = v;
+            dx[S + s] = - 1 / (r * r) + 1 / m * (T_max[s] * u - (A[s] * v * v * exp(-k * (r - r0))));
+            dx[2 * S + s] = -b * u;
+        }
+        return dx;
+    }
+
+    ProblemConfig::bundle_vector scenario_transition(const ProblemConfig::bundle_vector& x,
+                                                     const ProblemConfig::disc_vector& input,
+                                                     int /*i*/,
+                                                     double dt){
+        const std::size_t S = x.size() / 3;
+        ProblemConfig::bundle_vector k1 = f(x, input.at(0), S);
+        ProblemConfig::bundle_vector k2 = f(x + k1 * (dt / 2.0), input.at(0), S);
+        ProblemConfig::bundle_vector k3 = f(x + k2 * (dt / 2.0), input.at(0), S);
+        ProblemConfig::bundle_vector k4 = f(x + k3 * dt, input.at(0), S);
+
+        return x + (k1 + k2 * 2.0 + k3 * 2.0 + k4) * (dt / 6.0);
+    }
+
+    std::vector<double> scenario_cost(const ProblemConfig::bundle_vector& x,
+                                      const std::vector<double>& /*vi*/,
+                                      int /*i*/,
+                                      double /*dt*/){
+        const std::size_t S = x.size() / 3;
+        std::vector<double> c(S, 0);
+        for (std::size_t s = 0; s < S; ++s)
+            if ((A[s] * x[S + s] * x[S + s] * exp(-k * (x[s] - r0))) > C)
+                c[s] = 1e20;
+        return c;
+    }
+
+    ProblemConfig rck(std::size_t S) {
+        ProblemConfig config;
+        config.N = 1000;
+        config.v_feasible.assign(config.N, {{0}, {1}});
+        config.dt = 0.0005;
+        config.stage_cost = stage_cost;
+        config.objective = [](const std::vector<double>& x){return std::fabs(x.at(0));};
+        config.include_state = true;
+        config.x0 = {1.0, 0.0, 1.0};
+        config.scenarios = S;
+        config.scenario_transition = scenario_transition;
+        config.scenario_cost = scenario_cost;
+        double min_dwell_time = 0.01;
+        config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                                   {{0}, {min_dwell_time}}};
+        return config;
+    }
+}
+
+TEST(scenario_test, rck_robust) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/rck_robust.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_rck_robust.csv");
+
+// A bundle of the nominal scenario only gives the solution of rck_robust
+    Solver nominal(v_rel, SCENARIO::rck(1));
+    nominal.solve();
+    ASSERT_TRUE(nominal.solution.success);
+    EXPECT_EQ(nominal.solution.optimum_path, v_sol);
+
+// With all scenarios, the path keeps the state constraint of every scenario, in one solve
+    const std::size_t S = SCENARIO::A.size();
+    ProblemConfig config = SCENARIO::rck(S);
+    Solver robust(v_rel, config);
+    robust.solve();
+    ASSERT_TRUE(robust.solution.success);
+    ASSERT_EQ(robust.solution.optimum_traj.at(0).size(), 3 * S);
+
+    ProblemConfig::bundle_vector x(3 * S);
+    for (std::size_t r = 0; r < 3; ++r)
+        std::fill_n(x.begin() + r * S, S, config.x0[r]);
+    for (int i = 0; i < config.N - 1; ++i) {
+        x = SCENARIO::scenario_transition(x, robust.solution.optimum_path[i], i, config.dt);
+        for (double c: SCENARIO::scenario_cost(x, v_rel[0], i, config.dt))
+            EXPECT_EQ(c, 0);
+    }
+
+// Averaging the scenarios gives a cost that is never worse than the robust one
+    config.scenario_aggregate = ProblemConfig::Aggregate::Mean;
+    Solver mean(v_rel, config);
+    mean.solve();
+    EXPECT_LE(mean.solution.objective, robust.solution.objective);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include "DPapprox.h"
+
+namespace SEPARABLE {
+    using namespace DPapprox;
+
+    std::atomic<int> single{0};
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        if (vi.size() == 1)
+            ++single;
+        return {(vi - ri) * dt};
+    }
+
+    double objective(const std::vector<double> &x) {
+        double norm = 0;
+        for (double e: x)
+            norm = std::max(norm, std::abs(e));
+        return norm;
+    }
+}
+
+TEST(separable_test, trj) {
+    using namespace DPapprox;
+// Load data, with a second input that follows the first one shifted by half of the horizon
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    const int N = 500;
+    v_rel.push_back(std::vector<double>(N));
+    for (int i = 0; i < N; ++i)
+        v_rel[1][i] = v_rel[0][(i + N / 2) % N];
+
+// Define Problem, on the product of the values of the two inputs
+    ProblemConfig config;
+    config.N = N;
+    std::vector<ProblemConfig::disc_vector> product;
+    for (double a: {1.0, 0.0, -1.0})
+        for (double b: {1.0, 0.0, -1.0})
+            product.push_back({a, b});
+    config.v_feasible.assign(N, product);
+    config.dt = 0.02;
+    config.stage_cost = SEPARABLE::stage_cost;
+    config.objective = SEPARABLE::objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time, min_dwell_time}},
+                               {{0}, {min_dwell_time, min_dwell_time}},
+                               {{-1}, {min_dwell_time, min_dwell_time}}};
+    config.separable = true;
+
+// The decomposed solve runs a DP per input
+    Solver solver(v_rel, config);
+    solver.solve();
+    ASSERT_TRUE(solver.solution.success);
+    ASSERT_EQ(solver.solution.optimum_path.size(), static_cast<size_t>(N));
+    EXPECT_GT(SEPARABLE::single.load(), 0);
+
+// Each input follows the solution of its own problem, and the cost is summed over the full vectors
+    std::vector<double> cost(2, 0.0);
+    for (int d = 0; d < 2; ++d) {
+        ProblemConfig part = config;
+        part.separable = false;
+        part.v_feasible.assign(N, {{1}, {0}, {-1}});
+        for (auto &con: part.dwell_time_cons)
+            con.second = {min_dwell_time};
+        Solver reference({v_rel[d]}, part);
+        reference.solve();
+        for (int i = 0; i < N; ++i) {
+            EXPECT_DOUBLE_EQ(solver.solution.optimum_path[i][d], reference.solution.optimum_path[i][0]);
+            cost[d] += (solver.solution.optimum_path[i][d] - v_rel[d][i]) * config.dt;
+        }
+        EXPECT_NEAR(std::abs(cost[d]), reference.solution.objective, 1e-9);
+    }
+    EXPECT_NEAR(solver.solution.objective, SEPARABLE::objective(cost), 1e-9);
+
+// Without a product feasible set, the full problem is solved
+    SEPARABLE::single = 0;
+    config.v_feasible.assign(N, std::vector<ProblemConfig::disc_vector>(product.begin(), product.end() - 1));
+    Solver full(v_rel, config);
+    full.solve();
+    EXPECT_EQ(SEPARABLE::single.load(), 0);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "DPapprox.h"
+
+namespace SINGLE {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(single_test, isa_agree) {
+    using namespace DPapprox::kernels;
+// Random stage with ties and infeasible transitions, in float
+    const size_t n = 37, m = 19;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> level(-4, 4);
+    std::vector<float> V(n), c(m), pen(n * m);
+    for (auto &x: V) x = 0.25f * level(gen);
+    for (auto &x: c) x = 0.25f * level(gen);
+    for (auto &x: pen) x = (level(gen) > 2) ? 1e20f : 0.0f;
+
+    for (MinPlusOp op: {MinPlusOp::Identity, MinPlusOp::Absolute}) {
+        std::vector<float> cost_ref(m), cost(m);
+        std::vector<size_t> arg_ref(m), arg(m);
+        min_plus(V.data(), n, c.data(), pen.data(), m, op, cost_ref.data(), arg_ref.data(), MinPlusIsa::Scalar);
+        for (MinPlusIsa isa: {MinPlusIsa::AVX2, MinPlusIsa::AVX512}) {
+            min_plus(V.data(), n, c.data(), pen.data(), m, op, cost.data(), arg.data(), isa);
+            for (size_t j = 0; j < m; ++j) {
+                EXPECT_EQ(arg[j], arg_ref[j]);
+                EXPECT_FLOAT_EQ(cost[j], cost_ref[j]);
+            }
+        }
+    }
+}
+
+TEST(single_test, trj) {
+    using namespace DPapprox;
+// Load data, and keep a single precision copy of it
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<ProblemConfig::disc_vector> v_sol = read_csv("../../examples/data/sol_trj.csv");
+    std::vector<float> v_single(v_rel[0].begin(), v_rel[0].end());
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = SINGLE::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    config.objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// Float tables through the min-plus kernel, on float relaxed data
+    RelaxedView view(v_single.data(), 1, v_single.size(), 0, 1);
+    BasicSolver<float> kernel(view, config);
+    kernel.solve();
+
+// Float tables through the generic relaxation
+    config.objective_kind = ProblemConfig::ObjectiveKind::Custom;
+    BasicSolver<float> generic(v_rel, config);
+    generic.solve();
+
+// Both give the double precision result
+    for (const Solution *s: {&kernel.solution, &generic.solution}) {
+        ASSERT_TRUE(s->success);
+        ASSERT_EQ(s->optimum_path.size(), v_sol.size());
+        for (size_t i = 0; i < v_sol.size(); ++i)
+            EXPECT_DOUBLE_EQ(s->optimum_path[i][0], v_sol[i][0]);
+    }
+    EXPECT_NEAR(kernel.solution.objective, generic.solution.objective, 1e-6);
+}
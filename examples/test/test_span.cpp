@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace SPAN {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    void stage_cost_into(std::span<const double> vi, std::span<const double> ri, int, double dt, std::span<double> out) {
+        out[0] = (vi[0] - ri[0]) * dt;
+    }
+
+    ProblemConfig::traj_vector state_transition(const ProblemConfig::traj_vector &x, const ProblemConfig::disc_vector &vi,
+                                                int, double dt) {
+        return {x[0] + (vi[0] - x[0]) * dt / 0.1};
+    }
+
+    void state_transition_into(std::span<const double> x, std::span<const double> vi, int, double dt,
+                               std::span<double> out) {
+        out[0] = x[0] + (vi[0] - x[0]) * dt / 0.1;
+    }
+
+    std::vector<double> state_cost(const ProblemConfig::traj_vector &x, const std::vector<double> &, int, double) {
+        return {x[0] > 0.8 ? 1e20 : 0.0};
+    }
+
+    void state_cost_into(std::span<const double> x, std::span<const double>, int, double, std::span<double> out) {
+        out[0] = x[0] > 0.8 ? 1e20 : 0.0;
+    }
+}
+
+TEST(span_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem, with a state constraint on a lag of the input
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.objective = ProblemConfig::abs_objective;
+    config.include_state = true;
+    config.x0 = {0};
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+    ProblemConfig legacy = config;
+    legacy.stage_cost = SPAN::stage_cost;
+    legacy.state_transition = SPAN::state_transition;
+    legacy.state_cost = SPAN::state_cost;
+    Solver reference(v_rel, legacy);
+    reference.solve();
+
+// The span callbacks write into the buffers of the solver, and give the same solution
+    config.stage_cost_into = SPAN::stage_cost_into;
+    config.state_transition_into = SPAN::state_transition_into;
+    config.state_cost_into = SPAN::state_cost_into;
+    Solver solver(v_rel, config);
+    solver.solve();
+
+    ASSERT_TRUE(reference.solution.success);
+    EXPECT_EQ(solver.solution.optimum_path, reference.solution.optimum_path);
+    EXPECT_EQ(solver.solution.optimum_traj, reference.solution.optimum_traj);
+    EXPECT_DOUBLE_EQ(solver.solution.objective, reference.solution.objective);
+
+// The state bound holds along the trajectory
+    ProblemConfig::traj_vector x = config.x0;
+    for (int i = 0; i < config.N; ++i) {
+        x = SPAN::state_transition(x, solver.solution.optimum_path[i], i, config.dt);
+        EXPECT_LE(x[0], 0.8);
+    }
+
+// Engines that call the vector forms use adapters of the span callbacks
+    config.include_state = false;
+    legacy.include_state = false;
+    config.engine = legacy.engine = ProblemConfig::Engine::StateGraph;
+    Solver graph(v_rel, config), graph_reference(v_rel, legacy);
+    graph.solve();
+    graph_reference.solve();
+    EXPECT_EQ(graph.solution.optimum_path, graph_reference.solution.optimum_path);
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+#include "test_utils.h"
+
+namespace STATE_GRAPH {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(state_graph_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = STATE_GRAPH::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+    Solver labels(v_rel, config);
+    labels.solve();
+
+    config.engine = ProblemConfig::Engine::StateGraph;
+    Solver graph(v_rel, config);
+    graph.solve();
+
+// The exact dwell handling never does worse than the timers along the winning path
+    ASSERT_TRUE(graph.solution.success);
+    ASSERT_EQ(graph.solution.optimum_path.size(), static_cast<size_t>(config.N));
+    EXPECT_LE(graph.solution.objective, labels.solution.objective);
+
+// No value is left before its minimum dwell time of 15 nodes, except the first one
+    TEST_UTILS::expect_dwell(graph.solution.optimum_path, 15);
+}
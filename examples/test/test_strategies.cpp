@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "DPapprox.h"
+
+namespace STRATEGIES {
+    using namespace DPapprox;
+
+    double norm(const std::vector<double> &x) {
+        if (x.empty()) return 0.0;
+
+        double max_value = *std::max_element(x.begin(), x.end(), [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        });
+
+        return std::abs(max_value);
+    }
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    std::vector<double> custom_cost(std::vector<double> &V, std::vector<double> &cost_nxt, int i, double dt) {
+        double V_max = (i > 0) ? V.back() : norm(V);
+        if (i == 0)
+            V.push_back(V_max);
+
+        std::vector<double> cost(V.begin(), V.end() - 1);
+        std::vector<double> cost_max = cost + cost_nxt;
+        double V_nxt = norm(cost_max);
+
+        cost_max.push_back((V_nxt > V_max) ? V_nxt : V_max);
+
+        return cost_max;
+    }
+
+    // the callbacks of the examples, which the built-in strategies replace.
+    ProblemConfig callbacks(ProblemConfig config, ProblemConfig::Strategy strategy) {
+        switch (strategy) {
+            case ProblemConfig::Strategy::SumUp:
+                config.stage_cost = stage_cost;
+                config.objective = [](const std::vector<double> &x) { return std::fabs(x.at(0)); };
+                break;
+            case ProblemConfig::Strategy::SumUpInfNorm:
+                config.stage_cost = stage_cost;
+                config.objective = norm;
+                break;
+            case ProblemConfig::Strategy::CIA:
+                config.stage_cost = stage_cost;
+                config.objective = [](const std::vector<double> &x) { return x.back(); };
+                config.customize = true;
+                config.custom_cost = custom_cost;
+                break;
+            default:
+                break;
+        }
+        return config;
+    }
+
+    template<class Scalar = double>
+    void expect_same(const std::vector<std::vector<double>> &v_rel, ProblemConfig config,
+                     ProblemConfig::Strategy strategy) {
+        BasicSolver<Scalar> expected(v_rel, callbacks(config, strategy));
+        expected.solve();
+        config.strategy = strategy;
+        BasicSolver<Scalar> solver(v_rel, config);
+        solver.solve();
+
+        EXPECT_EQ(solver.solution.optimum_path, expected.solution.optimum_path);
+        EXPECT_EQ(solver.solution.cost, expected.solution.cost);
+        EXPECT_EQ(solver.solution.objective, expected.solution.objective);
+        EXPECT_EQ(solver.solution.success, expected.solution.success);
+        ASSERT_EQ(solver.solutions.size(), expected.solutions.size());
+        for (std::size_t r = 0; r < solver.solutions.size(); ++r) {
+            EXPECT_EQ(solver.solutions[r].optimum_path, expected.solutions[r].optimum_path);
+            EXPECT_EQ(solver.solutions[r].objective, expected.solutions[r].objective);
+        }
+    }
+}
+
+TEST(strategies_test, simple_rounding) {
+    using namespace DPapprox;
+// The mwe problem, whose default callbacks are simple rounding
+    std::vector<std::vector<double>> v_rel{{0.2, 0.8, 0.4}};
+    ProblemConfig config;
+    config.N = 3;
+    config.v_feasible = {{{0}, {1}}, {{0}, {1}}, {{0}, {1}}};
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::SimpleRounding);
+
+// The native kernel relaxes the ranked labels
+    config.k_best = 3;
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::SimpleRounding);
+}
+
+TEST(strategies_test, sum_up) {
+    using namespace DPapprox;
+// The rck problem, with the min-plus kernel and with the native kernel on ranked labels
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/rck.csv");
+    ProblemConfig config;
+    config.N = 1000;
+    config.v_feasible.assign(config.N, {{0}, {1}});
+    config.dt = 0.0005;
+    double min_dwell_time = 0.01;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}}};
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::SumUp);
+    config.k_best = 3;
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::SumUp);
+
+// SumUp is defined for a single input
+    config.v_feasible.assign(config.N, {{1, 0}, {0, 1}});
+    config.strategy = ProblemConfig::Strategy::SumUp;
+    EXPECT_THROW(Solver(v_rel, config), std::runtime_error);
+}
+
+TEST(strategies_test, sum_up_inf_norm) {
+    using namespace DPapprox;
+// The sos problem, in double and float
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/sos.csv");
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1, 0}, {0, 1}});
+    config.dt = 0.02;
+    double min_dwell_time = 0.2;
+    config.dwell_time_cons = { {{0}, {min_dwell_time, min_dwell_time}},
+                               {{1}, {0, 0}}};
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::SumUpInfNorm);
+    STRATEGIES::expect_same<float>(v_rel, config, ProblemConfig::Strategy::SumUpInfNorm);
+}
+
+TEST(strategies_test, cia) {
+    using namespace DPapprox;
+// The mat problem
+    std::vector<std::vector<double>> v_rel{{4.0/8.0, 0.0, 7.0/8.0, 7.0/8.0},
+                                           {3.0/8.0, 3.0/8.0, 1.0/8.0, 1.0/8.0},
+                                           {1.0/8.0, 5.0/8.0, 0.0, 0.0}};
+    ProblemConfig config;
+    config.N = 4;
+    config.dt = 1.0;
+    config.v_feasible.assign(config.N, {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+    config.dwell_time_cons = {{{1}, {1.5, 0.5, 0.5}}};
+    config.dwell_time_init = {{1.5, 0.5, 0.5}};
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::CIA);
+
+// A longer SOS1 problem with random relaxed columns, and with ranked labels
+    const int N = 300;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    v_rel.assign(3, std::vector<double>(N));
+    for (int i = 0; i < N; ++i) {
+        double a = unit(gen), b = unit(gen) * (1 - a);
+        v_rel[0][i] = a;
+        v_rel[1][i] = b;
+        v_rel[2][i] = 1 - a - b;
+    }
+    config.N = N;
+    config.dt = 0.01;
+    config.v_feasible.assign(N, {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+    config.dwell_time_cons = {{{1}, {0.03, 0.03, 0.03}}};
+    config.dwell_time_init = {};
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::CIA);
+    config.k_best = 2;
+    STRATEGIES::expect_same(v_rel, config, ProblemConfig::Strategy::CIA);
+}
+
+TEST(strategies_test, plan) {
+    using namespace DPapprox;
+// The plan knows the cost size of a strategy, and the scalar strategies run on the min-plus kernel
+    ProblemConfig config;
+    config.N = 10;
+    config.v_feasible.assign(config.N, {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+    config.strategy = ProblemConfig::Strategy::CIA;
+    ProblemConfig custom = STRATEGIES::callbacks(config, ProblemConfig::Strategy::CIA);
+    custom.strategy = ProblemConfig::Strategy::Custom;
+    EXPECT_EQ(Solver::plan(config, 3, 10).mode, Plan::Mode::Labels);
+    EXPECT_GT(Solver::plan(config, 3, 10).table_bytes, Solver::plan(custom, 3, 10).table_bytes);
+
+    config.v_feasible.assign(config.N, {{0}, {1}});
+    config.strategy = ProblemConfig::Strategy::SumUp;
+    EXPECT_EQ(Solver::plan(config, 1, 10).mode, Plan::Mode::MinPlus);
+}
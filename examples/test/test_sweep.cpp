@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include "DPapprox.h"
+
+namespace SWEEP {
+    using namespace DPapprox;
+
+    std::atomic<int> calls{0};
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        ++calls;
+        return {(vi - ri) * dt};
+    }
+
+    std::vector<std::pair<std::vector<int>, std::vector<double>>> dwell(double min_dwell_time) {
+        return { {{1}, {min_dwell_time}},
+                 {{0}, {min_dwell_time}},
+                 {{-1}, {min_dwell_time}}};
+    }
+}
+
+TEST(sweep_test, trj) {
+    using namespace DPapprox;
+// The trj problem over a range of minimum dwell times
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = SWEEP::stage_cost;
+    config.objective = [](const std::vector<double>& x){return std::fabs(x.at(0));};
+
+    std::vector<Variant> variants;
+    for (double min_dwell_time: {0.02, 0.1, 0.2, 0.3, 0.5}) {
+        Variant variant;
+        variant.dwell_time_cons = SWEEP::dwell(min_dwell_time);
+        variants.push_back(variant);
+    }
+    Variant squared;
+    squared.dwell_time_cons = SWEEP::dwell(0.3);
+    squared.objective = [](const std::vector<double> &x) { return x.at(0) * x.at(0); };
+    variants.push_back(squared);
+
+// The stage costs are computed once for all variants, which match separate solves
+    SWEEP::calls = 0;
+    Sweep sweep = Solver::sweep(v_rel, config, variants, 3);
+    EXPECT_EQ(SWEEP::calls, config.N * 3);
+    ASSERT_EQ(sweep.solutions.size(), variants.size());
+    ASSERT_EQ(sweep.summary.size(), variants.size());
+    for (std::size_t k = 0; k < variants.size(); ++k) {
+        ProblemConfig single = config;
+        single.dwell_time_cons = *variants[k].dwell_time_cons;
+        if (variants[k].objective)
+            single.objective = variants[k].objective;
+        Solver solver(v_rel, single);
+        solver.solve();
+        EXPECT_EQ(sweep.solutions[k].optimum_path, solver.solution.optimum_path);
+        EXPECT_EQ(sweep.solutions[k].cost, solver.solution.cost);
+        EXPECT_EQ(sweep.summary[k].variant, k);
+        EXPECT_EQ(sweep.summary[k].objective, solver.solution.objective);
+        EXPECT_TRUE(sweep.summary[k].success);
+    }
+
+// Longer dwell times switch less often, and the summary has a row per variant
+    EXPECT_GT(sweep.summary[0].switches, sweep.summary[4].switches);
+    std::ostringstream table;
+    table << sweep;
+    const std::string text = table.str();
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), static_cast<long>(variants.size() + 1));
+}
+
+TEST(sweep_test, strategy) {
+    using namespace DPapprox;
+// A sweep of a built-in strategy runs the min-plus kernel on the shared stage costs
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.strategy = ProblemConfig::Strategy::SumUp;
+
+    std::vector<Variant> variants(2);
+    variants[0].dwell_time_cons = SWEEP::dwell(0.3);
+    variants[1].dwell_time_cons = SWEEP::dwell(0.3);
+    variants[1].dwell_time_init = std::vector<std::vector<double>>{{0.3}, {0.3}, {0.3}};
+    Sweep sweep = Solver::sweep(v_rel, config, variants);
+    for (std::size_t k = 0; k < variants.size(); ++k) {
+        ProblemConfig single = config;
+        single.dwell_time_cons = *variants[k].dwell_time_cons;
+        if (variants[k].dwell_time_init)
+            single.dwell_time_init = *variants[k].dwell_time_init;
+        Solver solver(v_rel, single);
+        solver.solve();
+        EXPECT_EQ(sweep.solutions[k].optimum_path, solver.solution.optimum_path);
+        EXPECT_EQ(sweep.solutions[k].objective, solver.solution.objective);
+    }
+
+// The objective of a built-in strategy is fixed
+    variants[0].objective = ProblemConfig::default_objective;
+    EXPECT_THROW(Solver::sweep(v_rel, config, variants), std::runtime_error);
+}
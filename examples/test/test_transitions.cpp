@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace TRANSITIONS {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+
+    // 1 and -1 can only be reached through 0.
+    bool adjacent(const ProblemConfig::disc_vector &from, const ProblemConfig::disc_vector &to) {
+        return std::abs(from[0] - to[0]) <= 1;
+    }
+}
+
+TEST(transitions_test, trj) {
+    using namespace DPapprox;
+// Load data
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = TRANSITIONS::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// The relation given as an adjacency list over v_feasible[0], and as a predicate
+    config.transitions = {{0, 1}, {0, 1, 2}, {1, 2}};
+    Solver listed(v_rel, config);
+    listed.solve();
+
+    config.transitions.clear();
+    config.allowed_transition = TRANSITIONS::adjacent;
+    Solver predicate(v_rel, config);
+    predicate.solve();
+
+// The generic relaxation, and the state graph
+    config.objective = [](const std::vector<double> &x) { return std::abs(x.at(0)); };
+    Solver generic(v_rel, config);
+    generic.solve();
+
+    config.engine = ProblemConfig::Engine::StateGraph;
+    Solver graph(v_rel, config);
+    graph.solve();
+
+    ASSERT_TRUE(listed.solution.success);
+    EXPECT_EQ(predicate.solution.optimum_path, listed.solution.optimum_path);
+    EXPECT_EQ(generic.solution.optimum_path, listed.solution.optimum_path);
+    EXPECT_DOUBLE_EQ(generic.solution.objective, listed.solution.objective);
+    for (const Solver *s: {&listed, &graph}) {
+        ASSERT_TRUE(s->solution.success);
+        const auto &path = s->solution.optimum_path;
+        for (size_t i = 1; i < path.size(); ++i)
+            EXPECT_TRUE(TRANSITIONS::adjacent(path[i - 1], path[i]));
+    }
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "DPapprox.h"
+
+namespace UPDATE {
+    using namespace DPapprox;
+
+    std::vector<double> stage_cost(const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int i, double dt) {
+        return {(vi - ri) * dt};
+    }
+}
+
+TEST(update_test, trj) {
+    using namespace DPapprox;
+// Load data, and change the relaxed solution from node 300 on
+    std::vector<std::vector<double>> v_rel = read_csv("../../examples/data/trj.csv");
+    std::vector<std::vector<double>> v_mod = v_rel;
+    const int k = 300;
+    for (size_t i = k; i < v_mod[0].size(); ++i)
+        v_mod[0][i] = -v_mod[0][i];
+
+// Define Problem
+    ProblemConfig config;
+    config.N = 500;
+    config.v_feasible.assign(config.N, {{1}, {0}, {-1}});
+    config.dt = 0.02;
+    config.stage_cost = UPDATE::stage_cost;
+    config.objective = ProblemConfig::abs_objective;
+    double min_dwell_time = 0.3;
+    config.dwell_time_cons = { {{1}, {min_dwell_time}},
+                               {{0}, {min_dwell_time}},
+                               {{-1}, {min_dwell_time}}};
+
+// With the min-plus kernel and with the generic relaxation, the update gives the solution of a fresh solve
+    for (auto kind: {ProblemConfig::ObjectiveKind::Absolute, ProblemConfig::ObjectiveKind::Custom}) {
+        config.objective_kind = kind;
+        Solver solver(v_rel, config);
+        solver.solve();
+        std::vector<ProblemConfig::disc_vector> before = solver.solution.optimum_path;
+        solver.update(v_mod, k);
+
+        Solver fresh(v_mod, config);
+        fresh.solve();
+        ASSERT_TRUE(solver.solution.success);
+        EXPECT_EQ(solver.solution.optimum_path, fresh.solution.optimum_path);
+        EXPECT_DOUBLE_EQ(solver.solution.objective, fresh.solution.objective);
+        EXPECT_NE(solver.solution.optimum_path, before);
+
+// Updating back restores the first solution
+        solver.update(RelaxedView(v_rel), k);
+        EXPECT_EQ(solver.solution.optimum_path, before);
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef DPAPPROX_TEST_UTILS_H
+#define DPAPPROX_TEST_UTILS_H
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace TEST_UTILS {
+
+    // expects every value of [path] to be kept for at least [min_nodes] nodes before it is left, except the first
+    // one, whose dwell time may have started before the path.
+    template<class T>
+    void expect_dwell(const std::vector<T> &path, size_t min_nodes) {
+        size_t run = 0, first = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            ++run;
+            if (path[i] != path[i - 1]) {
+                if (first++ > 0) {
+                    EXPECT_GE(run, min_nodes) << "value left at node " << i;
+                }
+                run = 0;
+            }
+        }
+    }
+}
+
+#endif
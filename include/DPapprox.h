@@ -14,13 +14,28 @@
 #include <unordered_map>
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <cstdint>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <ostream>
 #include "config.h"
 #include "io_utils.h"
 #include "vector_ops.h"
+#include "min_plus.h"
+#include "relaxed_view.h"
+#include "policy.h"
+#include "back_pointers.h"
+#include "memo_cache.h"
 #include "./logger.h"
 
 namespace DPapprox {
 
+class StateGraph;
+
 /*
  * Global parameters for Solver
  * EPSILON  : epsilon is used to make sure dwell times always round up to the closest next time node.
@@ -32,6 +47,17 @@ constexpr double EPSILON = 1e-9;
 const std::vector<double> INFTY {1e20};
 constexpr double DWELL_FLAG = -2;
 
+/*
+ * Limits<Scalar> : the infinity penalty in the cost tables of a BasicSolver<Scalar>. EPSILON and DWELL_FLAG belong to
+ * the dwell timers, which are double for every Scalar: they are decremented by dt at every node, and rounding them in
+ * float would move dwell time boundaries over long horizons.
+ */
+
+template<class Scalar>
+struct Limits {
+    static constexpr Scalar infty = static_cast<Scalar>(1e20);
+};
+
 /*
  * Solution structure includes the following:
  * optimum_path : the optimum path to go from the final point to the beginning, i.e. the optimal discrete approximation.
@@ -39,59 +65,386 @@ constexpr double DWELL_FLAG = -2;
  * cost         : the optimum approximation cost for the optimum path.
  * objective    : the optimum objective for the optimum path.
  * success      : a boolean that is true if objective is less than [INFTY].
+ * status       : [Solved] if the DP ran over all nodes, [Infeasible] if every label at a node hit [INFTY], and
+ *                [Cancelled] or [Deadline] if it was stopped by [ProblemConfig::cancel] or [ProblemConfig::deadline].
+ * last_node    : the last node reached by the DP. Unless [Solved], the path after [last_node] is a fallback greedy
+ *                rounding that ignores the dwell time constraints and allowed transitions, the traj is replayed along
+ *                the path, and success is false.
  */
 
 struct Solution {
+    enum class Status { Solved, Infeasible, Cancelled, Deadline };
+
     std::vector<ProblemConfig::disc_vector> optimum_path;
     std::vector<ProblemConfig::traj_vector> optimum_traj;
     std::vector<double> cost;
     double objective;
     bool success;
+    Status status{Status::Solved};
+    int last_node{-1};
+};
+
+/*
+ * Progress structure is published by a running Solver, and can be read from another thread without locking:
+ * stage    : the last stage relaxed by the DP, -1 before the first one.
+ * objective: the best objective among the labels of the frontier node, [INFTY] at first.
+ * elapsed  : the seconds since the start of the solve.
+ * running  : whether a solve is in progress.
+ */
+
+struct Progress {
+    std::atomic<int> stage{-1};
+    std::atomic<double> objective{INFTY.at(0)};
+    std::atomic<double> elapsed{0.0};
+    std::atomic<bool> running{false};
 };
 
+/*
+ * Plan structure is the prediction of a solve by Solver::plan(), from the problem and the shape of [v_rel]:
+ * mode         : the way Solver would solve the problem. [Labels] and [MinPlus] are the labels DP with the generic
+ *                relaxation or the min-plus kernel, [Coarsened], [Multiresolution] and [Separable] run inner Solvers.
+ * labels       : the number of labels of the DP tables, or states times nodes for [StateGraph].
+ * transitions  : the number of transitions relaxed by the DP, after the allowed transitions, summed over the inner
+ *                Solvers.
+ * table_bytes  : the size of the cost, timer, state and index tables, without the back pointers.
+ * path_bytes   : the size of the back pointers, in memory unless [path_spilled] to a file.
+ * workspace_bytes : the size of the buffers of a stage.
+ * peak_bytes   : the memory a Solver takes at its peak, including the inner Solvers. The corridor of a
+ *                multiresolution solve and the stages of a coarsened one depend on [v_rel], so they are bounded by the
+ *                full problem.
+ */
+
+struct Plan {
+    enum class Mode { Labels, MinPlus, StateGraph, Coarsened, Multiresolution, Separable };
+
+    Mode mode{Mode::Labels};
+    std::size_t labels{0};
+    std::size_t transitions{0};
+    std::size_t table_bytes{0};
+    std::size_t path_bytes{0};
+    bool path_spilled{false};
+    std::size_t workspace_bytes{0};
+    std::size_t peak_bytes{0};
+};
+
+/*
+ * Variant structure is one point of a parameter sweep by Solver::sweep(), which replaces the fields of the swept
+ * problem that are set:
+ * dwell_time_cons, dwell_time_init : the dwell time constraints and the initial timers, see [ProblemConfig].
+ * objective    : the objective. It cannot replace the objective of a built-in [ProblemConfig::Strategy].
+ *
+ * SweepRow structure is the summary of the solve of a variant:
+ * variant      : the index of the variant.
+ * objective, success, status : those of its solution.
+ * switches     : the number of nodes where the path changes its value.
+ * seconds      : the wall time of its solve.
+ *
+ * Sweep structure holds the [solutions] of the variants in their order, and the [summary] table, which operator<<
+ * prints with one row per variant.
+ */
+
+struct Variant {
+    std::optional<std::vector<std::pair<std::vector<int>, std::vector<double>>>> dwell_time_cons;
+    std::optional<std::vector<std::vector<double>>> dwell_time_init;
+    std::function<double(const std::vector<double> &)> objective{};
+};
+
+struct SweepRow {
+    std::size_t variant{0};
+    double objective{0};
+    bool success{false};
+    Solution::Status status{Solution::Status::Solved};
+    int switches{0};
+    double seconds{0};
+};
+
+struct Sweep {
+    std::vector<Solution> solutions;
+    std::vector<SweepRow> summary;
+};
+
+std::ostream &operator<<(std::ostream &os, const Sweep &sweep);
+
+/*
+ * interruption() : the status a solve of [config] stops with at a stage boundary, or [Solved] to continue.
+ */
+
+Solution::Status interruption(const ProblemConfig &config);
+
 /*
  * Solver class that receives the relaxed solution [v_rel] and an approximation problem [ProblemConfig] and solves
  * the approximation problem using DP algorithm.
  *
- * Solver() : constructs the Solver, by receiving a [v_rel] and a [ProblemConfig].
- * solve()  : solves the discrete approximation problem.
+ * BasicSolver<Scalar> stores the cost tables and runs the min-plus kernel in [Scalar], double or float. Solver is
+ * BasicSolver<double>. With float, the tables take half the memory traffic and the kernel twice the lanes, while the
+ * callbacks, the dwell timers, the states and the solution stay double. [Engine::StateGraph] always runs in double.
+ *
+ * Solver() : constructs the Solver, by receiving a [v_rel] and a [ProblemConfig]. [v_rel] is copied when given as
+ *            a vector, and borrowed when given as a [RelaxedView], in which case its data must outlive the Solver or
+ *            the next reset(). [config] is copied, unless it is shared through a [std::shared_ptr].
+ *            All tables and workspace of the Solver are allocated from [resource]. By default, the Solver owns a
+ *            monotonic arena sized from N and the feasible sets, which is released in one shot with the Solver.
+ * reset()  : replaces [v_rel] for the next solve, with the same copy or borrow semantics as the constructor.
+ * update() : replaces [v_rel] like reset(), where the columns before [first_changed] are unchanged, and solves again.
+ *            [Engine::Labels] keeps the labels of the nodes before [first_changed] and only runs the DP from there,
+ *            other engines and coarsened or multiresolution solves run from the start.
+ * solve()  : solves the discrete approximation problem. It can be called repeatedly, the tables keep their capacity
+ *            between solves, so a warmed-up Solver does not allocate them again.
+ * solve_async() : runs solve() on another thread and returns its solution. The Solver must outlive the future, and
+ *            must not be used until the future is ready.
+ * progress() : the live [Progress] of the solve, which another thread can poll, e.g. to decide on a cancellation.
+ *            The solver stores it with relaxed atomics once per stage, and calls [ProblemConfig::progress_callback].
+ * memo_stats() : the hits, misses and evictions of the caches of state_transition and state_cost, see
+ *            [ProblemConfig::memo_capacity].
+ * plan()   : predicts the mode, table sizes, transitions and peak memory of a solve of [config] with a [v_rel] of
+ *            [rows] inputs and [cols] nodes, see [Plan], without allocating the tables. It calls stage_cost once to
+ *            find the size of the costs.
+ * sweep()  : solves [config] on [v_rel] for each of the [variants], see [Sweep], on [threads] threads (0 for the
+ *            hardware concurrency). The stage costs are computed once, and shared read only by the Solvers of the
+ *            variants, which borrow [v_rel]. The objective and state callbacks are called from several threads.
+ * policy() : compiles the feedback policy of the problem on the state graph by a backward DP, see [Policy]. It needs
+ *            neither a state nor a customized constraint check, since the states of the graph are the only memory of
+ *            the policy, and an additive objective ([ObjectiveKind::Identity]), for which the cost to go is exact.
  * solution : records the solution based on [Solution] structure.
+ * solutions: the [ProblemConfig::k_best] best paths in ranked order when k_best > 1, with their cost and objective,
+ *            where solutions[0] is [solution]. The traj of the other paths is replayed along them. It is filled by a
+ *            solve of [Engine::Labels] that reaches the last node, with fewer paths if fewer feasible paths exist, and
+ *            is empty otherwise. A multiresolution solve ranks the paths of its fine grid.
  *
+ * config       : owns or shares the problem that [dp] refers to. With scenarios, it is a copy whose state callbacks
+ *                run on bundles, and whose state cost aggregates the scenarios.
  * dp   : the problem to be solved using DP algorithm.
- * v_rel: the relaxed solution.
- * timers       : timers variables that are run along the optimum paths to detect dwell time constraint violation.
- * cost_to_go   : the discrete approximation cost to go. It provides the cost to go for each pair of <disc_vector, i>.
- * path_to_go   : the discrete approximation path to go. It provides the [disc_vector] to go for each pair of <disc_vector, i>.
- * next_state   : specifies the next [traj_vector] to go for each pain of <disc_vector, i>.
+ * v_rel: the view of the relaxed solution, either on [owned_v_rel] or on borrowed data.
+ * graph        : the state graph of the problem when [ProblemConfig::engine] is [Engine::StateGraph], built once.
+ * coarse       : the Solver of the reduced problem when [ProblemConfig::coarsen_tolerance] is set, or of the coarse
+ *                grid of a multiresolution solve.
+ * fine         : the Solver of the fine grid of a multiresolution solve, restricted to the corridor.
+ * hold         : the number of nodes merged into each node of a reduced problem, empty otherwise.
+ * parts        : the Solvers of the input dimensions of a separable problem, built once.
+ * stages       : the stage costs of every value at every node shared by the Solvers of a sweep, or null.
+ * arena        : the default memory resource, and its initial buffer.
+ * resource     : the memory resource of all tables and workspace.
+ *
+ * The DP tables hold one label per pair of <disc_vector, i>, stored flat over all nodes. The labels of node i are
+ * offset[i] ... offset[i + 1] - 1, in the order of v_feasible[i].
+ * offset       : the first label of each node.
+ * dim          : the size of the costs at each node, and cost_offset their first element in [cost_to_go].
+ * cost_to_go   : the discrete approximation cost to go of each label, in [Scalar].
+ * path_to_go   : the discrete approximation path to go. It provides the label of node i - 1 to go for each label,
+ *                bit-packed, and spilled to a file beyond [ProblemConfig::path_budget] (see back_pointers.h).
+ * reached      : whether a label has a finite path to go.
+ * timers       : timers variables that are run along the optimum paths to detect dwell time constraint violation,
+ *                [slots] values per label (one per dwell time constraint and input dimension).
+ * next_state   : specifies the next [traj_vector] to go for each label.
+ * transition_memo, state_cost_memo : the caches of state_transition and state_cost, sized by the first solve that
+ *                has [ProblemConfig::memo_capacity] and states.
+ *
+ * col, col_nxt : the relaxed solution at nodes i and i + 1 of the current stage.
+ * c, pen, best, arg    : stage costs, dwell penalties and results of the min-plus kernel.
+ * allowed_offset, allowed_source : the allowed transitions of the stage from [allowed_node], in CSR form grouped by
+ *                successor. The predecessors of value j are allowed_source[allowed_offset[j]] ... .
+ * stage, step, cost_nxt, candidate, V, p, x, dwell : workspace of the generic relaxation. Buffers handed to
+ *                user callbacks are [std::vector] as the callbacks require, and keep their capacity over the solve.
+ *                The span callbacks write into them in place.
+ * opt, dwell_opt : the cost and timers of the best candidate of a value at node i + 1.
+ *
+ * The runners-up of [ProblemConfig::k_best] are enumerated after the DP from its tables, by the recursive enumeration
+ * algorithm of the k shortest paths: the next path into a label extends the next path into the predecessor of its last
+ * path, or the best path into another predecessor. Only the labels the runners-up go through are enumerated. A
+ * predecessor whose next path violates a dwell time constraint gives no further candidates, which keeps the work
+ * linear in k_best; the paths then rank exactly for additive costs without dwell time constraints only.
+ * Ranked       : a path into a label: its objective, the value index and rank of the path it extends at the previous
+ *                node, and its cost, timers and state.
+ * RankedLabel  : the paths found into a label in ranked order, the candidates for the next one in a heap, the
+ *                <predecessor, rank> pairs still to be extended into candidates, and whether the candidates of all
+ *                predecessors were set up, or no path is left.
+ * ranked       : the enumerated labels, keyed by label, and by offset[N] for the end of the paths.
  *
- * set_timers   : initializes the timers for dwell time constraints.
+ * progress, start, reported : the published progress, the start of the solve, and the elapsed seconds of the last
+ *                call of the progress callback.
+ * frontier     : the best objective at node i + 1 after relaxing stage i.
+ * publish      : stores the progress of [stage], and calls the progress callback when it is due or [last].
+ * make_arena   : creates the default arena, sized from the problem by [estimate].
+ * reset_tables : sizes the tables for the next solve.
+ * truncate_tables : clears the labels from node [first] onward, keeping the tables before it.
+ * valid_nodes  : the number of nodes whose labels are up to date with [v_rel]. A later solve() continues after them,
+ *                which also resumes a cancelled solve.
+ * solve_labels : runs the DP of [Engine::Labels].
+ * solve_coarse : merges nodes into stages, solves the reduced problem, and expands its solution back to N nodes.
+ * separable    : whether the problem is declared separable and decomposes, see [ProblemConfig::separable], with
+ *                [decomposes] on the problem and the number of [rows] of [v_rel].
+ * part         : the subproblem of dimension [d] of a separable problem.
+ * estimate     : the sizes of the labels DP of [dp] with costs of [dim] elements, which also size the arena.
+ * plan_of      : plan() of a preprocessed problem.
+ * solve_separable : solves the dimensions in parallel, and recombines their paths, costs and status.
+ * solve_multires : solves on a grid coarsened by [ProblemConfig::multires_factor], then at full resolution within a
+ *                corridor around the coarse path, widened where the fine solve hits [INFTY].
+ * store_cost   : writes the cost of label j at node i.
+ * stage_cost_at : the stage cost of value j at node i, with the relaxed column [r] of node i, from [stages] when
+ *                they are shared.
+ * stage_cost, state_cost, state_transition, custom_cost : call the span form of a callback into [out] when it is set,
+ *                and its vector form otherwise. custom_cost reads [V] and [cost_nxt]. state_transition of input [j]
+ *                and state_cost look their result up in [transition_memo] and [state_cost_memo] first. stage_cost
+ *                runs the kernel of a built-in strategy instead.
+ * relax        : relaxes all transitions from node i to node i + 1 with the user defined cost functions, keeping the
+ *                best candidate of every value.
+ * relax_native : relaxes node i to node i + 1 like relax, with the kernels of a built-in [Strategy] (see
+ *                strategies.h) instead of the callbacks.
+ * relax_min_plus : relaxes node i to node i + 1 with the vectorized min-plus kernel (scalar cost, no states).
+ *                All three return false if every label at node i + 1 hit [INFTY].
+ * state_costs  : the state costs [p] of the labels of node i.
+ * store_best   : writes the best candidate of value j at node i + 1, from label k at node i, into the tables.
+ * backtrack    : the path to go of [label] at node [last].
+ * enumerate    : fills [solutions] with the [ProblemConfig::k_best] best paths, the solution first.
+ * ranked_label : the enumerated label of value j at node i, with the path of the tables as its first one, or the end
+ *                of the paths for i = N.
+ * find_ranked  : finds the paths into the label of value j at node i up to rank r, and returns false if there are
+ *                fewer.
+ * extend       : the path into value j at node i that extends path [rank] into value k at node i - 1, and returns
+ *                false on a dwell time violation or an objective of [INFTY].
+ * fallback     : completes a stopped [solution] after [last_node] by greedy rounding, and replays its traj.
+ * allowed      : builds the allowed transitions of stage i, unless the stage shares the feasible sets of the last one,
+ *                and returns false if all transitions are allowed.
+ * min_plus_op  : checks whether [dp] with costs of [dim] elements qualifies for the min-plus kernel, and returns the
+ *                matching operation.
+ * dwell_check  : fills [dwell] with the timers at [node] after [timers] moving to [vni], and returns true on a
+ *                violation.
+ * dwell_lock   : marks in [locked] the inputs that label [from] with values [vi] may not leave yet.
+ * dwell_blocked : whether moving from [vi] to [vni] leaves an input marked by dwell_lock.
+ * run_down     : decrements the timers over the [hold] - 1 nodes after the first one of a merged stage.
  * dwell_time   : it checks the optimum paths for violating the dwell time constraints.
  */
 
-class Solver {
+template<class Scalar = double>
+class BasicSolver {
 
 public:
-    Solver(const std::vector<std::vector<double>> &v_rel, const ProblemConfig &config);
+    BasicSolver(const std::vector<std::vector<double>> &v_rel, const ProblemConfig &config,
+                std::pmr::memory_resource *resource = nullptr);
+    BasicSolver(const RelaxedView &v_rel, const ProblemConfig &config, std::pmr::memory_resource *resource = nullptr);
+    BasicSolver(const RelaxedView &v_rel, std::shared_ptr<const ProblemConfig> config,
+                std::pmr::memory_resource *resource = nullptr);
+    ~BasicSolver();
+    void reset(const std::vector<std::vector<double>> &v_rel);
+    void reset(const RelaxedView &v_rel);
+    void update(const std::vector<std::vector<double>> &v_rel, int first_changed);
+    void update(const RelaxedView &v_rel, int first_changed);
     void solve();
+    std::future<Solution> solve_async();
+    Policy policy();
+    MemoStats memo_stats() const;
+    const Progress &progress() const;
+    static Plan plan(const ProblemConfig &config, std::size_t rows, std::size_t cols);
+    static Sweep sweep(const RelaxedView &v_rel, const ProblemConfig &config, const std::vector<Variant> &variants,
+                       unsigned threads = 0);
     Solution solution;
+    std::vector<Solution> solutions;
 
 private:
-    ProblemConfig _dp;
-    std::vector<std::vector<double>> _v_rel;
+    std::shared_ptr<const ProblemConfig> _config;
+    const ProblemConfig &_dp;
+    std::vector<std::vector<double>> _owned_v_rel;
+    RelaxedView _v_rel;
+    std::unique_ptr<StateGraph> _graph;
+    std::unique_ptr<BasicSolver> _coarse;
+    std::unique_ptr<BasicSolver> _fine;
+    std::vector<int> _hold;
+    std::vector<std::unique_ptr<BasicSolver>> _parts;
+    struct StageTable;
+    std::shared_ptr<const StageTable> _stages;
 
-    std::vector<ProblemConfig::CostMap> _timers;
-    ProblemConfig::CostMap _cost_to_go;
-    ProblemConfig::PathMap _path_to_go;
-    ProblemConfig::PathMap _next_state;
+    std::unique_ptr<std::byte[]> _arena_buffer;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> _arena;
+    std::pmr::memory_resource *_resource;
 
-    void _set_timers();
+    std::size_t _slots{0};
+    std::pmr::vector<std::size_t> _offset;
+    std::pmr::vector<std::size_t> _dim;
+    std::pmr::vector<std::size_t> _cost_offset;
+    std::pmr::vector<Scalar> _cost_to_go;
+    BackPointers _path_to_go;
+    std::pmr::vector<char> _reached;
+    std::pmr::vector<double> _timers;
+    std::pmr::vector<double> _next_state;
+    MemoCache _transition_memo, _state_cost_memo;
 
-    std::vector<double>
-    _dwell_time(const std::pair<std::vector<int>, std::vector<double>> &con,
-               std::vector<double> yi,
-               const ProblemConfig::disc_vector& vi,
-               const ProblemConfig::disc_vector& vni, int i) const;
+    std::pmr::vector<Scalar> _c, _pen, _best;
+    std::pmr::vector<char> _locked;
+    std::pmr::vector<double> _dwell, _dwell_opt;
+    std::pmr::vector<std::size_t> _arg;
+    std::pmr::vector<std::uint32_t> _allowed_offset, _allowed_source;
+    int _allowed_node{-1};
+    int _valid_nodes{0};
+    Progress _progress;
+    std::chrono::steady_clock::time_point _start;
+    double _reported{0};
+    double _frontier{0};
+    std::vector<double> _col, _col_nxt, _stage, _step, _cost_nxt, _candidate, _opt, _V, _x;
+    std::vector<std::vector<double>> _p;
+
+    struct Ranked {
+        double objective;
+        std::size_t from, rank;
+        std::vector<double> cost, timers, state;
+    };
+    struct RankedLabel {
+        std::vector<Ranked> paths, candidates;
+        std::vector<std::pair<std::size_t, std::size_t>> pending;
+        bool initialized{false}, exhausted{false};
+    };
+    std::unordered_map<std::size_t, RankedLabel> _ranked;
+
+    void _publish(int stage, double objective, bool last);
+    std::pmr::monotonic_buffer_resource *_make_arena();
+    void _reset_tables();
+    void _truncate_tables(int first);
+    void _solve_labels();
+    void _solve_coarse();
+    void _solve_multires();
+    bool _separable() const;
+    static bool _decomposes(const ProblemConfig &dp, std::size_t rows);
+    static std::shared_ptr<ProblemConfig> _part(const ProblemConfig &dp, std::size_t d);
+    void _solve_separable();
+    static Plan _estimate(const ProblemConfig &dp, std::size_t dim);
+    static Plan _plan_of(const ProblemConfig &dp, std::size_t rows);
+    void _store_cost(int i, std::size_t j, const std::vector<double> &cost);
+    void _stage_cost_at(int i, std::size_t j, const std::vector<double> &r, std::vector<double> &out) const;
+    void _stage_cost(const ProblemConfig::disc_vector &v, const std::vector<double> &r, int i,
+                     std::vector<double> &out) const;
+    void _state_cost(const double *x, const std::vector<double> &r, int i, std::vector<double> &out);
+    void _state_transition(const double *x, const ProblemConfig::disc_vector &v, int i, std::size_t j, double *out);
+    void _custom_cost(int i, std::vector<double> &out);
+    bool _relax(int i);
+    template<class Strategy>
+    bool _relax_native(int i);
+    void _state_costs(int i);
+    void _store_best(int i, std::size_t j, std::size_t k);
+    bool _relax_min_plus(int i, kernels::MinPlusOp op);
+    void _backtrack(int last, std::size_t label, std::vector<ProblemConfig::disc_vector> &path) const;
+    void _enumerate();
+    RankedLabel &_ranked_label(int i, std::size_t j);
+    bool _find_ranked(int i, std::size_t j, std::size_t r);
+    bool _extend(int i, std::size_t j, std::size_t k, std::size_t rank, Ranked &out);
+    void _fallback();
+    bool _allowed(int i);
+    static bool _min_plus_op(const ProblemConfig &dp, std::size_t dim, kernels::MinPlusOp &op);
+    bool _dwell_check(int node, const double *timers, const ProblemConfig::disc_vector &vi,
+                      const ProblemConfig::disc_vector &vni, double *dwell) const;
+    void _dwell_lock(std::size_t from, const ProblemConfig::disc_vector &vi, char *locked) const;
+    static bool _dwell_blocked(const char *locked, const ProblemConfig::disc_vector &vi,
+                               const ProblemConfig::disc_vector &vni);
+    void _run_down(double *dwell, int hold) const;
+
+    void _dwell_time(const std::pair<std::vector<int>, std::vector<double>> &con,
+                     const double *yi,
+                     const ProblemConfig::disc_vector& vi,
+                     const ProblemConfig::disc_vector& vni, double *yni) const;
 };
 
+using Solver = BasicSolver<double>;
+
+extern template class BasicSolver<double>;
+extern template class BasicSolver<float>;
+
 }
 #endif
@@ -0,0 +1,102 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_BACK_POINTERS_H
+#define DPAPPROX_BACK_POINTERS_H
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+namespace DPapprox {
+
+/*
+ * BackPointers is the bit-packed table of the winning predecessor of every label, used by Solver to backtrack the
+ * optimum path. The labels of node i > 0 take ceil(log2 |v_feasible[i - 1]|) bits each (at most 32), node 0 takes
+ * none.
+ *
+ * reset()  : sizes the table for the nodes given by [offset] (the first label of each node, N + 1 entries). When the
+ *            table takes more than [budget] bytes (0 for no limit), it is kept in a memory-mapped temporary file,
+ *            which the kernel pages out, instead of memory.
+ * set()    : stores the predecessor [k] of label j at node i.
+ * get()    : the predecessor of label j at node i. The entries of labels that were never set are unspecified.
+ * spilled(): whether the table is in a file.
+ * bytes()  : the size of the table.
+ *
+ * width    : the bits per label of each node, and bit the first bit of each node.
+ * words    : the table in memory, [data] points to it or to the mapped file.
+ */
+
+class BackPointers {
+
+public:
+    explicit BackPointers(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    BackPointers(const BackPointers &) = delete;
+    BackPointers &operator=(const BackPointers &) = delete;
+    ~BackPointers();
+
+    template<class Offset>
+    void reset(const Offset &offset, std::size_t budget);
+    void set(int i, std::size_t j, std::uint32_t k) {
+        const std::uint64_t w = _width[i];
+        const std::uint64_t pos = _bit[i] + j * w;
+        const std::uint64_t word = pos >> 6, shift = pos & 63;
+        const std::uint64_t mask = (std::uint64_t{1} << w) - 1;
+        _data[word] = (_data[word] & ~(mask << shift)) | (static_cast<std::uint64_t>(k) << shift);
+        if (shift + w > 64) {
+            const std::uint64_t rest = 64 - shift;
+            _data[word + 1] = (_data[word + 1] & ~(mask >> rest)) | (static_cast<std::uint64_t>(k) >> rest);
+        }
+    }
+    std::uint32_t get(int i, std::size_t j) const {
+        const std::uint64_t w = _width[i];
+        const std::uint64_t pos = _bit[i] + j * w;
+        const std::uint64_t word = pos >> 6, shift = pos & 63;
+        const std::uint64_t mask = (std::uint64_t{1} << w) - 1;
+        std::uint64_t value = _data[word] >> shift;
+        if (shift + w > 64)
+            value |= _data[word + 1] << (64 - shift);
+        return static_cast<std::uint32_t>(value & mask);
+    }
+    bool spilled() const { return _map != nullptr; }
+    std::size_t bytes() const { return _n_words * sizeof(std::uint64_t); }
+
+private:
+    void _allocate(std::size_t n_words, std::size_t budget);
+    void _unmap();
+
+    std::pmr::vector<std::uint8_t> _width;
+    std::pmr::vector<std::uint64_t> _bit;
+    std::pmr::vector<std::uint64_t> _words;
+    std::uint64_t *_data{nullptr};
+    std::size_t _n_words{0};
+    void *_map{nullptr};
+    std::size_t _map_size{0};
+};
+
+template<class Offset>
+void BackPointers::reset(const Offset &offset, std::size_t budget) {
+    const std::size_t N = offset.size() - 1;
+    _width.assign(N, 0);
+    _bit.assign(N + 1, 0);
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i > 0) {
+            const std::size_t n_pred = offset[i] - offset[i - 1];
+            while ((std::size_t{1} << _width[i]) < n_pred)
+                ++_width[i];
+        }
+        _bit[i + 1] = _bit[i] + (offset[i + 1] - offset[i]) * _width[i];
+    }
+    // one spare word, so that an entry straddling the last word boundary stays in range.
+    _allocate(_bit[N] / 64 + 2, budget);
+}
+
+}
+#endif
@@ -13,6 +13,10 @@
 #include <functional>
 #include <array>
 #include <cmath>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <span>
 
 /* ProblemConfig defines the problem DPapprox solves:
  *
@@ -29,13 +33,81 @@
  *
  * stage_cost       : the stage or running cost of discrete approximation.
  * objective        : the function that receives the approximation cost and returns the objective function to be optimized.
+ * objective_kind   : declares what [objective] computes from a single-element cost: [Identity] (the cost, as
+ *                    default_objective) or [Absolute] (its absolute value, as abs_objective), which lets Solver relax
+ *                    the stages with the min-plus kernel. [Auto] (default) infers it when [objective] is one of these
+ *                    two functions, and [Custom] makes no assumption and runs the callbacks. resolved_objective_kind()
+ *                    gives the kind with [Auto] inferred, [Custom] if [objective] is not a built-in function.
  * state_transition : a function that transitions the system state from previous state to the next.
  * state_cost       : the cost of system states. useful for enforcing state constraints.
  * custom_cost      : the function that takes all the information about the optimum path (cost_to_go) and (path_to_go)
  *                    to allow the user full control over the approximation cost.
+ * strategy         : a built-in approximation strategy of docs/approximations.md, run by native kernels of fixed cost
+ *                    layout (see strategies.h) in place of stage_cost, objective and custom_cost, which it overrides.
+ *                    [SimpleRounding] (as mwe), [SumUp] of a single input (as trj and rck), [SumUpInfNorm] (as sos)
+ *                    and [CIA] (as mat) give the same results as those callbacks. The callbacks are set to their
+ *                    equivalents for the code paths that call them. [Custom] (default) runs the callbacks.
  *
  * dwell_time_cons  : a vector that defines the minimum dwell time constraints.
  * dwell_time_init  : a vector that defines the initial value of timers for the minimum dwell time constraints.
+ *
+ * transitions      : an optional adjacency list over the values of v_feasible[0]: transitions[a] holds the indices of
+ *                    the values that may follow value a. Values that are not in v_feasible[0] are not restricted.
+ * allowed_transition : an optional predicate telling whether a value may follow another one. Only the allowed
+ *                    transitions are relaxed. With both, a transition must be allowed by both.
+ *
+ * engine           : the DP run by Solver. [Labels] keeps one label per <disc_vector, i> and carries the dwell timers
+ *                    along the winning path. [StateGraph] expands each value into <disc_vector, remaining dwell steps>
+ *                    states, which handles dwell time constraints exactly (see state_graph.h).
+ *
+ * scenarios        : the number S of parameter scenarios a path is checked against, 0 to disable. With scenarios, each
+ *                    label carries a bundle of S states, stored SoA: element r of scenario s is at [r * S + s]. [x0]
+ *                    is the initial state of every scenario, and optimum_traj holds bundles.
+ * scenario_transition : transitions a bundle of states, all S scenarios in one call.
+ * scenario_cost    : the state costs of a bundle, element c of scenario s at [c * S + s].
+ * scenario_aggregate : aggregates the state costs of the scenarios per element, by [Max] (robust) or [Mean].
+ *
+ * coarsen_tolerance : merges consecutive nodes whose relaxed columns differ from the first node of their stage by at
+ *                    most the tolerance (and have the same feasible set) into one stage, over which the discrete value
+ *                    is constant. Negative to disable. Requires [Engine::Labels], without include_state and customize.
+ * multires_factor  : the number of nodes per coarse node of a coarse-to-fine solve, which first solves on a grid with
+ *                    averaged relaxed columns and a time step of [multires_factor] dt. 0 or 1 to disable.
+ * corridor         : the number of coarse nodes around each node whose coarse values are allowed in the fine solve.
+ * separable        : declares that the problem separates over the input dimensions: stage_cost and objective called on
+ *                    a single dimension (its value and relaxed row) give the subproblem of that dimension, and
+ *                    minimizing every subproblem minimizes the objective. When v_feasible is moreover the product of
+ *                    the values of each dimension at every node, Solver solves the dimensions as independent DPs in
+ *                    parallel, with the dwell time constraints of each dimension, and recombines their paths. The
+ *                    callbacks are then called from several threads. Requires no states, customize, scenarios,
+ *                    allowed transitions and k_best, otherwise the full problem is solved.
+ *
+ * stage_cost_into, state_transition_into, state_cost_into, custom_cost_into : optional allocation-free forms of the
+ *                    callbacks above, with the same arguments as std::span (V is read only), which write their result
+ *                    into a caller-owned [out] span instead of returning a vector. [out] has [cost_dim] elements for
+ *                    stage_cost_into and custom_cost_into, [state_cost_dim] for state_cost_into, and x0.size() for
+ *                    state_transition_into. When set, a span callback replaces its vector form, which is then adapted
+ *                    from it for the code paths that need a vector.
+ * cost_dim, state_cost_dim : the declared sizes of the costs written by the span callbacks.
+ *
+ * path_budget      : the memory budget in bytes of the back pointers of the labels DP, beyond which they are kept in a
+ *                    memory-mapped temporary file. 0 for no limit.
+ * memo_capacity    : the number of entries of the caches of state_transition and state_cost, which setting it declares
+ *                    pure: their results are looked up by (node, input index, quantized state) instead of recomputed.
+ *                    The state cost cache is dropped when the relaxed solution changes. 0 (default) disables them.
+ * memo_quantum     : the grid on which the states of the cache keys are quantized, so that states within a cell share
+ *                    one result. 0 (default) keys the exact states.
+ * k_best           : the number of distinct paths [Engine::Labels] enumerates from the tables of its DP after the
+ *                    solve, so that one solve gives the [k_best] best paths (see Solver::solutions). 1 by default.
+ *
+ * cancel           : an optional cancellation token. Once it is set to true, Solver stops at the next stage.
+ * deadline         : the time by which Solver stops at the next stage. It is unbounded by default.
+ * progress_callback : an optional function called from the solving thread with the current stage, the best objective
+ *                    at the frontier and the elapsed seconds, at most once per [progress_interval] seconds, and once
+ *                    when the solve ends. It runs on the critical path, so it should return quickly.
+ * phase_callback   : an optional function called from the solving thread when the labels DP enters (true) and leaves
+ *                    (false) each of its phases: [Setup] of the tables and node 0, [Relax] of the stages, and
+ *                    [Backtrack] of the paths. The inner Solvers of coarsened and multiresolution solves call it
+ *                    too, the ones of a separable solve do not.
  */
 
 namespace DPapprox {
@@ -53,6 +125,12 @@ struct ProblemConfig {
     bool include_state{false};
     bool customize{false};
 
+    enum class Strategy { Custom, SimpleRounding, SumUp, SumUpInfNorm, CIA };
+    Strategy strategy{Strategy::Custom};
+
+    enum class ObjectiveKind { Auto, Custom, Identity, Absolute };
+    ObjectiveKind objective_kind{ObjectiveKind::Auto};
+
     std::function<std::vector<double>(const disc_vector &, const std::vector<double> &, int, double)> stage_cost{
             default_stage_cost};
     std::function<double(const std::vector<double> &)> objective{
@@ -65,6 +143,46 @@ struct ProblemConfig {
     std::vector<std::pair<std::vector<int>, std::vector<double>>> dwell_time_cons;
     std::vector<std::vector<double>> dwell_time_init{};
 
+    std::vector<std::vector<std::size_t>> transitions{};
+    std::function<bool(const disc_vector &, const disc_vector &)> allowed_transition{};
+
+    enum class Engine { Labels, StateGraph };
+    Engine engine{Engine::Labels};
+
+    using bundle_vector = std::vector<double>;
+    enum class Aggregate { Max, Mean };
+
+    std::size_t scenarios{0};
+    std::function<bundle_vector(const bundle_vector &, const disc_vector &, int, double)> scenario_transition{};
+    std::function<std::vector<double>(const bundle_vector &, const std::vector<double> &, int, double)> scenario_cost{};
+    Aggregate scenario_aggregate{Aggregate::Max};
+
+    double coarsen_tolerance{-1};
+    int multires_factor{0};
+    int corridor{1};
+    bool separable{false};
+
+    using span_callback = std::function<void(std::span<const double>, std::span<const double>, int, double,
+                                             std::span<double>)>;
+    span_callback stage_cost_into{};
+    span_callback state_transition_into{};
+    span_callback state_cost_into{};
+    span_callback custom_cost_into{};
+    std::size_t cost_dim{1};
+    std::size_t state_cost_dim{1};
+
+    std::size_t path_budget{0};
+    std::size_t memo_capacity{0};
+    double memo_quantum{0};
+    int k_best{1};
+
+    std::shared_ptr<std::atomic<bool>> cancel{};
+    std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+    std::function<void(int, double, double)> progress_callback{};
+    double progress_interval{0.1};
+    enum class Phase { Setup, Relax, Backtrack };
+    std::function<void(Phase, bool)> phase_callback{};
+
     static std::vector<double> default_stage_cost(const disc_vector &vi, const std::vector<double> &ri, int, double) {
         return std::vector<double>{std::abs(vi[0] - ri[0])};
     };
@@ -73,6 +191,23 @@ struct ProblemConfig {
         return x.at(0);
     };
 
+    static double abs_objective(const std::vector<double> &x) {
+        return std::abs(x.at(0));
+    };
+
+    ObjectiveKind resolved_objective_kind() const {
+        // a built-in objective is recognized by the function it holds.
+        if (objective_kind != ObjectiveKind::Auto)
+            return objective_kind;
+        using Function = double (*)(const std::vector<double> &);
+        const Function *f = objective.target<Function>();
+        if (f && *f == &default_objective)
+            return ObjectiveKind::Identity;
+        if (f && *f == &abs_objective)
+            return ObjectiveKind::Absolute;
+        return ObjectiveKind::Custom;
+    }
+
     static std::vector<double> default_state_cost(const traj_vector &xi, const std::vector<double> &, int, double) {
         return std::vector<double>{0};
     };
@@ -0,0 +1,170 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_C_H
+#define DPAPPROX_C_H
+
+#include <stddef.h>
+
+/*
+ * C interface of DPapprox, for embedding the solver in runtimes that are not C++.
+ *
+ * The solver is an opaque handle. All structures passed in start with [struct_size], which must be set to
+ * sizeof(struct) by the caller so that fields can be appended in later versions without breaking the ABI: the library
+ * reads and writes only the fields that fit in [struct_size], and the fields a caller does not know take their
+ * defaults (zero, or NULL for callbacks).
+ * Matrices are described by a pointer and strides counted in elements, and are never copied: the relaxed solution
+ * is read in place during solve, and results are written into buffers owned by the caller.
+ *
+ * dpapprox_abi_version   : the ABI version the library was built with, compare with [DPAPPROX_ABI_VERSION].
+ * dpapprox_last_error    : a message describing the last failure on the calling thread.
+ * dpapprox_solver_create : creates a solver for [problem] on the relaxed solution [v_rel], which has n_inputs rows
+ *                          and N columns. [problem] and the arrays it points to are copied and can be released on
+ *                          return, but the data of [v_rel] is read in place and must stay valid until the solver is
+ *                          reset or destroyed. The callbacks and [user_data] must stay valid as long as the solver.
+ * dpapprox_solver_reset  : replaces the relaxed solution with [v_rel], which must have n_inputs rows and N columns.
+ *                          The solver keeps its tables, so that one solver can be reused for a sequence of relaxed
+ *                          solutions.
+ * dpapprox_solver_solve  : solves the discrete approximation problem. It can be called repeatedly.
+ * dpapprox_solver_result : writes the last solution into the buffers of [result].
+ * dpapprox_solver_destroy: releases the solver.
+ */
+
+#define DPAPPROX_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dpapprox_solver dpapprox_solver;
+
+typedef enum {
+    DPAPPROX_OK = 0,
+    DPAPPROX_ERROR_ARGUMENT = 1,    /* invalid or inconsistent argument */
+    DPAPPROX_ERROR_CALLBACK = 2,    /* a user callback returned non-zero */
+    DPAPPROX_ERROR_SOLVER = 3,      /* the solver failed */
+    DPAPPROX_ERROR_NOT_SOLVED = 4,  /* result requested before solve */
+    DPAPPROX_ERROR_BUFFER = 5       /* a result buffer is too small */
+} dpapprox_status;
+
+/* Element <r, i> is data[r * row_stride + i * col_stride]. Rows are inputs (or states), columns are time nodes. */
+typedef struct {
+    const double *data;
+    size_t rows;
+    size_t cols;
+    ptrdiff_t row_stride;
+    ptrdiff_t col_stride;
+} dpapprox_matrix;
+
+typedef struct {
+    double *data;
+    size_t rows;
+    size_t cols;
+    ptrdiff_t row_stride;
+    ptrdiff_t col_stride;
+} dpapprox_buffer;
+
+/*
+ * Feasible discrete values, each of [n_inputs] elements stored contiguously in [values].
+ * If [node_offsets] is NULL, the first [n_values] values are feasible at every node. Otherwise node i uses values
+ * node_offsets[i] ... node_offsets[i + 1] - 1 and [node_offsets] has N + 1 increasing entries, at most [n_values].
+ */
+typedef struct {
+    const double *values;
+    size_t n_inputs;
+    size_t n_values;
+    const size_t *node_offsets;
+} dpapprox_feasible;
+
+/* A minimum dwell time constraint on [sequence], with [min_dwell] and optional [init] timers per input. */
+typedef struct {
+    const int *sequence;
+    size_t sequence_length;
+    const double *min_dwell;
+    const double *init;
+} dpapprox_dwell;
+
+/* Callbacks return 0 on success. [out] holds [cost_dim] (or [nx] for transitions) elements. */
+typedef int (*dpapprox_stage_cost_fn)(const double *v, const double *r, size_t n_inputs, int i, double dt,
+                                      double *out, size_t cost_dim, void *user_data);
+typedef double (*dpapprox_objective_fn)(const double *cost, size_t cost_dim, void *user_data);
+typedef int (*dpapprox_state_transition_fn)(const double *x, size_t nx, const double *v, size_t n_inputs, int i,
+                                            double dt, double *out, void *user_data);
+typedef int (*dpapprox_state_cost_fn)(const double *x, size_t nx, const double *r, size_t n_inputs, int i,
+                                      double dt, double *out, size_t cost_dim, void *user_data);
+
+typedef enum {
+    DPAPPROX_ENGINE_LABELS = 0,
+    DPAPPROX_ENGINE_STATE_GRAPH = 1
+} dpapprox_engine;
+
+/*
+ * Problem definition, mirroring ProblemConfig. Callbacks left NULL take the defaults of ProblemConfig
+ * (simple rounding of the first input, objective on the first cost element, zero dynamics and state cost).
+ * [cost_dim] is the size of the stage and state costs, [user_data] is passed to every callback.
+ */
+typedef struct {
+    size_t struct_size;
+    int N;
+    double dt;
+    dpapprox_feasible feasible;
+    const dpapprox_dwell *dwell;
+    size_t n_dwell;
+    size_t cost_dim;
+    dpapprox_stage_cost_fn stage_cost;
+    dpapprox_objective_fn objective;
+    int include_state;
+    const double *x0;
+    size_t nx;
+    dpapprox_state_transition_fn state_transition;
+    dpapprox_state_cost_fn state_cost;
+    dpapprox_engine engine;
+    void *user_data;
+} dpapprox_problem;
+
+/* How a solve ended, mirroring Solution::Status. */
+typedef enum {
+    DPAPPROX_SOLVED = 0,            /* the DP ran over all nodes */
+    DPAPPROX_INFEASIBLE = 1,        /* every label at a node hit INFTY */
+    DPAPPROX_CANCELLED = 2,         /* the solve was cancelled */
+    DPAPPROX_DEADLINE = 3           /* the solve ran past its deadline */
+} dpapprox_solve_status;
+
+/*
+ * Result buffers. [path] receives n_inputs x N values, [traj] (optional, when states are included) nx x (N + 1)
+ * states, and [cost] up to [cost_capacity] elements. [cost_dim], [objective], [success], [status] and [last_node]
+ * are written back. Unless [status] is DPAPPROX_SOLVED, the path after [last_node] is a fallback greedy rounding.
+ */
+typedef struct {
+    size_t struct_size;
+    dpapprox_buffer path;
+    dpapprox_buffer traj;
+    double *cost;
+    size_t cost_capacity;
+    size_t cost_dim;
+    double objective;
+    int success;
+    dpapprox_solve_status status;
+    int last_node;
+} dpapprox_result;
+
+unsigned dpapprox_abi_version(void);
+const char *dpapprox_last_error(void);
+
+dpapprox_status dpapprox_solver_create(const dpapprox_problem *problem, const dpapprox_matrix *v_rel,
+                                       dpapprox_solver **solver);
+dpapprox_status dpapprox_solver_reset(dpapprox_solver *solver, const dpapprox_matrix *v_rel);
+dpapprox_status dpapprox_solver_solve(dpapprox_solver *solver);
+dpapprox_status dpapprox_solver_result(const dpapprox_solver *solver, dpapprox_result *result);
+void dpapprox_solver_destroy(dpapprox_solver *solver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
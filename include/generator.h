@@ -0,0 +1,69 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_GENERATOR_H
+#define DPAPPROX_GENERATOR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "config.h"
+
+/*
+ * utilities for generating synthetic problems of any size, e.g. for scaling and stress tests.
+ *
+ * GeneratorSpec describes a problem. The same spec, including its seed, always gives the same problem:
+ * N            : number of time nodes.
+ * nv           : input dimension.
+ * levels       : every input takes the values 0, ..., levels - 1, so there are levels^nv feasible values.
+ * dt           : time discretization step.
+ * smoothness   : the correlation length of the relaxed inputs, as a fraction of the horizon.
+ * chattering   : the amplitude of a fast alternating component added to the relaxed inputs, in levels.
+ * min_dwell_time : the minimum dwell time of every level of every input, 0 for none.
+ * state        : adds a first order lag of the inputs as system state, like the states of rck_robust, whose value
+ *                must stay below [state_bound] (a state constraint through state_cost).
+ * tau          : the time constant of the lag.
+ * state_bound  : the bound of the lagged inputs, in levels.
+ * seed         : the seed of the random relaxed inputs.
+ *
+ * generate_relaxed : the relaxed inputs, one row per input and one column per node, as read by read_csv.
+ * generate_config  : the matching ProblemConfig. The stage cost is the deviation from the relaxed inputs, and the
+ *                    objective the largest accumulated deviation of one input (abs_objective for nv == 1).
+ * write_spec / read_spec : writes / reads a spec as a text file of "key = value" lines. Keys that are not given keep
+ *                    their default, unknown keys are an error.
+ * set_spec         : sets one key of a spec from its text value.
+ */
+namespace DPapprox {
+
+struct GeneratorSpec {
+    int N{1000};
+    std::size_t nv{1};
+    int levels{3};
+    double dt{0.01};
+    double smoothness{0.05};
+    double chattering{0.0};
+    double min_dwell_time{0.0};
+    bool state{false};
+    double tau{0.1};
+    double state_bound{1.5};
+    std::uint64_t seed{0};
+};
+
+std::vector<std::vector<double>> generate_relaxed(const GeneratorSpec &spec);
+
+ProblemConfig generate_config(const GeneratorSpec &spec);
+
+void write_spec(const std::string &filename, const GeneratorSpec &spec);
+
+GeneratorSpec read_spec(const std::string &filename);
+
+void set_spec(GeneratorSpec &spec, const std::string &key, const std::string &value);
+
+}
+#endif
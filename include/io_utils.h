@@ -22,8 +22,11 @@ namespace DPapprox {
 
 std::vector<std::vector<double>> read_csv(const std::string &filename);
 
-
-void write_csv(const std::string &filename, const std::vector<std::vector<double>> &data);
+/*
+ * write_csv : writes [data] to [filename], one row per line. Returns false, after logging the error, if the file could
+ *             not be opened or written.
+ */
+bool write_csv(const std::string &filename, const std::vector<std::vector<double>> &data);
 
 /*
  * get_column : a utility function to get a column slice out of vectors.
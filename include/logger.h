@@ -11,6 +11,7 @@
 #define LOGGER_H
 
 #include <iostream>
+#include <atomic>
 
 namespace DPapprox {
 
@@ -48,15 +49,18 @@ public:
     }
 
     Logger& operator<<(std::ostream& (*manip)(std::ostream&)) {
-        std::cout << manip;
+        if (currentMsgLevel >= threshold) {
+            std::cout << manip;
+        }
         return *this;
     }
 
 private:
-    Logger() : threshold(DEBUG), currentMsgLevel(DEBUG) {}
+    Logger() : threshold(DEBUG) {}
 
-    LogLevel threshold;
-    LogLevel currentMsgLevel;
+    // solvers log from several threads, each message keeps the level of its own thread.
+    std::atomic<LogLevel> threshold;
+    inline static thread_local LogLevel currentMsgLevel{DEBUG};
 };
 
 inline Logger& Log = Logger::instance();
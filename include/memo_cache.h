@@ -0,0 +1,78 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_MEMO_CACHE_H
+#define DPAPPROX_MEMO_CACHE_H
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+namespace DPapprox {
+
+/*
+ * MemoStats : the counters of a memo cache. A lookup is a hit or a miss, and an eviction is an insert that replaced
+ * another entry.
+ */
+
+struct MemoStats {
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t evictions{0};
+};
+
+/*
+ * MemoCache is a bounded open-addressing table of the results of a pure callback, keyed by (node, input index,
+ * quantized state), used by Solver to turn repeated state_transition and state_cost evaluations into lookups.
+ *
+ * reset()  : sizes the table to [capacity] entries (rounded up to a power of two) of [nx] state elements, and clears
+ *            it. States are quantized on a grid of [quantum], or compared bit for bit when it is 0.
+ * clear()  : drops all entries, keeping the counters.
+ * find()   : the cached result of (node, input, x), [width] elements, or nullptr.
+ * insert() : caches [n] elements of [value] for (node, input, x). The first insert sets [width], and results of
+ *            another size are not cached. A key probes [PROBES] slots from its hash, and replaces the entry at its
+ *            hash when none of them is free.
+ * stats()  : the counters since the last reset().
+ *
+ * keys     : node, input and the quantized state of each slot, [nx] + 2 words, with a node of -1 for a free slot.
+ * values   : [width] elements per slot, allocated by the first insert.
+ * key      : the key of the current lookup.
+ */
+
+class MemoCache {
+
+public:
+    static constexpr std::size_t PROBES = 8;
+
+    explicit MemoCache(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    void reset(std::size_t capacity, std::size_t nx, double quantum);
+    void clear();
+    const double *find(int node, std::size_t input, const double *x);
+    void insert(int node, std::size_t input, const double *x, const double *value, std::size_t n);
+    bool enabled() const { return !_keys.empty(); }
+    std::size_t width() const { return _width; }
+    const MemoStats &stats() const { return _stats; }
+
+private:
+    void _quantize(int node, std::size_t input, const double *x);
+    std::size_t _hash() const;
+    bool _match(std::size_t slot) const;
+
+    std::size_t _nx{0}, _width{0}, _mask{0};
+    double _quantum{0};
+    std::pmr::vector<std::int64_t> _keys;
+    std::pmr::vector<double> _values;
+    std::pmr::vector<std::int64_t> _key;
+    MemoStats _stats;
+};
+
+}
+#endif
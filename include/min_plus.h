@@ -0,0 +1,52 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_MIN_PLUS_H
+#define DPAPPROX_MIN_PLUS_H
+
+#include <cstddef>
+
+/*
+ * Min-plus relaxation kernel used by Solver when the approximation cost is a scalar.
+ *
+ * MinPlusOp    : the objective applied to the scalar cost, either identity (x) or absolute value (|x|).
+ * MinPlusIsa   : the instruction set a kernel is implemented with.
+ *
+ * min_plus     : for every successor j in [0, n_succ), finds the predecessor k in [0, n_pred) minimizing
+ *                op(V[k] + (c[j] + pen[j * n_pred + k])). The signed cost of the winner is written to cost[j] and its
+ *                index to arg[j]. Ties keep the first index. If no candidate is finite, arg[j] is set to n_pred.
+ *                The float overloads run twice as many lanes per instruction.
+ * min_plus_isa : the instruction set selected at runtime for this CPU.
+ */
+
+namespace DPapprox::kernels {
+
+enum class MinPlusOp { Identity, Absolute };
+enum class MinPlusIsa { Scalar, AVX2, AVX512 };
+
+void min_plus(const double *V, std::size_t n_pred,
+              const double *c, const double *pen, std::size_t n_succ,
+              MinPlusOp op, double *cost, std::size_t *arg);
+
+void min_plus(const double *V, std::size_t n_pred,
+              const double *c, const double *pen, std::size_t n_succ,
+              MinPlusOp op, double *cost, std::size_t *arg, MinPlusIsa isa);
+
+void min_plus(const float *V, std::size_t n_pred,
+              const float *c, const float *pen, std::size_t n_succ,
+              MinPlusOp op, float *cost, std::size_t *arg);
+
+void min_plus(const float *V, std::size_t n_pred,
+              const float *c, const float *pen, std::size_t n_succ,
+              MinPlusOp op, float *cost, std::size_t *arg, MinPlusIsa isa);
+
+MinPlusIsa min_plus_isa();
+
+}
+#endif
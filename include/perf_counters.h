@@ -0,0 +1,65 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_PERF_COUNTERS_H
+#define DPAPPROX_PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace DPapprox {
+
+/*
+ * PerfSample : the counts of the events of PerfCounters over an interval, and whether each event could be counted.
+ */
+
+struct PerfSample {
+    enum Event { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, PageFaults, EVENTS };
+
+    std::array<std::uint64_t, EVENTS> count{};
+    std::array<bool, EVENTS> valid{};
+
+    PerfSample &operator+=(const PerfSample &other);
+    static const char *name(Event event);
+};
+
+/*
+ * PerfCounters reads the hardware and software counters of the calling thread with Linux perf_event_open, in user
+ * space only, e.g. around the phases of Solver::solve() (see [ProblemConfig::phase_callback]). The threads it starts
+ * after the counters are opened, such as the workers of Solver::sweep() and of separable solves, are counted too, but
+ * their counts are added only when they exit, so a read() sees the work of the threads joined before it.
+ *
+ * PerfCounters() : opens every event of [PerfSample] that the kernel and the machine allow. Events that cannot be
+ *            opened (no PMU in a virtual machine, perf_event_paranoid > 2, or another OS) are not valid in the
+ *            samples, and the others keep counting.
+ * available(): whether any event is counted.
+ * read()   : the counts since the counters were opened, scaled up when the kernel multiplexed them.
+ *            The counts of an interval are the difference of two reads, see [since].
+ * since()  : the counts between the sample [start] of read() and now.
+ */
+
+class PerfCounters {
+
+public:
+    PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    ~PerfCounters();
+
+    bool available() const;
+    PerfSample read() const;
+    PerfSample since(const PerfSample &start) const;
+
+private:
+    std::array<int, PerfSample::EVENTS> _fd;
+};
+
+}
+#endif
@@ -0,0 +1,118 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_POLICY_H
+#define DPAPPROX_POLICY_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "config.h"
+
+namespace DPapprox {
+
+/*
+ * Policy is a feedback policy over the states <disc_vector, remaining dwell steps> of the state graph: for every node
+ * and state, the best state to move to at the next node and the cost to go from there. It is compiled by
+ * Solver::policy() with a backward DP, and looked up in O(1) by a controller, e.g. after a disturbance, without running
+ * the solver.
+ *
+ * The policy is one flat binary image, which load() maps into memory without parsing. The image starts with a
+ * [PolicyHeader], followed by 8-byte aligned arrays at the byte offsets given in the header:
+ * values       : double[n_values * nv], the distinct feasible values.
+ * radix        : int32[slots], the number of step counts of each slot.
+ * index        : int32[n_values * n_keys], the state of <value, steps>, -1 if unreachable. The key of the steps is
+ *                mixed radix, with the first slot varying fastest.
+ * state_value  : int32[n_states], the value of each state.
+ * state_steps  : int32[n_states * slots], the remaining dwell steps of each state.
+ * next         : int32[N * n_states], the best state at node i + 1 of each state at node i, -1 if none.
+ * cost         : double[N * n_states], the cost to go of each state at node i: the least sum of the stage costs of
+ *                nodes i + 1 ... N - 1 over the paths from it, infinite if there is none.
+ *
+ * from_tables  : builds a policy from its arrays.
+ * load / save  : maps a policy file into memory, after checking that its sections lie within it for the counts of
+ *                its header / writes the image of a policy to a file.
+ * state()      : the state of value u with the remaining dwell [steps] (one per slot), -1 if it is unreachable.
+ * next()       : the best state at node i + 1 from state s at node i, -1 if there is none.
+ * cost_to_go() : the cost to go of state s at node i, so that cost_to_go(i, s) is the stage cost of next(i, s) at
+ *                node i + 1 plus cost_to_go(i + 1, next(i, s)).
+ * start()      : the best state at node 0, from the initial dwell timers.
+ */
+
+struct PolicyHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian;
+    std::int64_t N;
+    std::int64_t n_values;
+    std::int64_t nv;
+    std::int64_t slots;
+    std::int64_t n_states;
+    std::int64_t n_keys;
+    std::int64_t start;
+    std::uint64_t values;
+    std::uint64_t radix;
+    std::uint64_t index;
+    std::uint64_t state_value;
+    std::uint64_t state_steps;
+    std::uint64_t next;
+    std::uint64_t cost;
+    std::uint64_t size;
+};
+
+class Policy {
+
+public:
+    static Policy from_tables(int N, const std::vector<ProblemConfig::disc_vector> &values, std::size_t slots,
+                              const std::vector<int> &state_value, const std::vector<int> &state_steps,
+                              const std::vector<std::int32_t> &next, const std::vector<double> &cost,
+                              std::int32_t start);
+    static Policy load(const std::string &filename);
+    void save(const std::string &filename) const;
+
+    Policy(Policy &&other) noexcept;
+    Policy &operator=(Policy &&other) noexcept;
+    Policy(const Policy &) = delete;
+    Policy &operator=(const Policy &) = delete;
+    ~Policy();
+
+    int N() const { return static_cast<int>(_header->N); }
+    std::size_t n_values() const { return static_cast<std::size_t>(_header->n_values); }
+    std::size_t n_states() const { return static_cast<std::size_t>(_header->n_states); }
+    std::size_t slots() const { return static_cast<std::size_t>(_header->slots); }
+
+    ProblemConfig::disc_vector value(std::size_t u) const;
+    std::int32_t state(std::size_t u, const int *steps) const;
+    std::size_t state_value(std::int32_t s) const { return static_cast<std::size_t>(_state_value[s]); }
+    const std::int32_t *state_steps(std::int32_t s) const { return _state_steps + s * _header->slots; }
+    std::int32_t next(int i, std::int32_t s) const { return _next[i * _header->n_states + s]; }
+    double cost_to_go(int i, std::int32_t s) const { return _cost[i * _header->n_states + s]; }
+    std::int32_t start() const { return static_cast<std::int32_t>(_header->start); }
+
+private:
+    Policy() = default;
+    void _attach(const std::byte *data);
+
+    std::vector<std::byte> _owned;
+    void *_map{nullptr};
+    std::size_t _map_size{0};
+
+    const PolicyHeader *_header{nullptr};
+    const double *_values{nullptr};
+    const std::int32_t *_radix{nullptr};
+    const std::int32_t *_index{nullptr};
+    const std::int32_t *_state_value{nullptr};
+    const std::int32_t *_state_steps{nullptr};
+    const std::int32_t *_next{nullptr};
+    const double *_cost{nullptr};
+};
+
+}
+#endif
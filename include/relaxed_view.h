@@ -0,0 +1,59 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_RELAXED_VIEW_H
+#define DPAPPROX_RELAXED_VIEW_H
+
+#include <vector>
+#include <cstddef>
+
+namespace DPapprox {
+
+/*
+ * RelaxedView is a non-owning view of a relaxed solution with one row per input and one column per time node.
+ * The data must outlive the view.
+ *
+ * RelaxedView(v_rel)  : views a [std::vector<std::vector<double>>], as returned by read_csv.
+ * RelaxedView(data, rows, cols, row_stride, col_stride) : views a strided buffer, where element <r, i> is
+ *                       data[r * row_stride + i * col_stride] (strides in elements). [data] is either double or float,
+ *                       a float buffer halves the memory read for large relaxed solutions, and is widened on access.
+ *
+ * rows()   : the number of inputs.
+ * cols()   : the number of time nodes.
+ * at(r, i) : the relaxed value of input r at node i.
+ * column() : copies the values of all inputs at node i into [out].
+ */
+
+class RelaxedView {
+
+public:
+    RelaxedView() = default;
+    RelaxedView(const std::vector<std::vector<double>> &v_rel);
+    RelaxedView(const double *data, std::size_t rows, std::size_t cols,
+                std::ptrdiff_t row_stride, std::ptrdiff_t col_stride);
+    RelaxedView(const float *data, std::size_t rows, std::size_t cols,
+                std::ptrdiff_t row_stride, std::ptrdiff_t col_stride);
+
+    std::size_t rows() const { return _row.size() + _row_single.size(); }
+    std::size_t cols() const { return _cols; }
+    double at(std::size_t r, std::size_t i) const {
+        const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(i) * _col_stride;
+        return _row_single.empty() ? _row[r][offset] : _row_single[r][offset];
+    }
+    void column(std::size_t i, std::vector<double> &out) const;
+
+private:
+    std::vector<const double *> _row;
+    std::vector<const float *> _row_single;
+    std::size_t _cols{0};
+    std::ptrdiff_t _col_stride{1};
+};
+
+}
+#endif
@@ -0,0 +1,77 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_STATE_GRAPH_H
+#define DPAPPROX_STATE_GRAPH_H
+
+#include <vector>
+#include <cstdint>
+#include "DPapprox.h"
+#include "policy.h"
+
+namespace DPapprox {
+
+/*
+ * StateGraph is the dwell-augmented DP used by Solver when [ProblemConfig::engine] is [Engine::StateGraph].
+ *
+ * Each feasible value is expanded into states <value, remaining dwell steps>, with one step counter per dwell time
+ * constraint and input dimension (a slot). A transition between two states does not depend on the time node, so the
+ * reachable states and their transitions are built once. The DP then keeps one label per state instead of one per
+ * value, which makes the dwell time constraints exact, and runs over flat per-stage arrays.
+ *
+ * StateGraph() : builds the states reachable from [dwell_time_init] and the transitions between them.
+ * solve()      : runs the DP on [v_rel] and returns the optimum path, or the path up to the node the DP stopped at
+ *                (see [Solution::status]).
+ * policy()     : runs the DP backward on [v_rel] and returns the next state and cost to go of every state and node.
+ *                It requires an additive objective ([ObjectiveKind::Identity]) and single-element stage costs.
+ * size()       : the number of states.
+ * edges()      : the number of transitions between states.
+ *
+ * values       : the distinct feasible values over the horizon, states refer to them by index.
+ * feasible     : for each node and value, whether the value is in [v_feasible] at that node.
+ * fresh        : the steps a timer stays active after it is set to the minimum dwell time of a slot.
+ * n_init       : the number of initial states, which come first.
+ * state_value  : the value index of each state.
+ * state_steps  : the remaining dwell steps of each state, [slots] entries per state.
+ * in_offset    : the transitions in CSR form, grouped by target state. The predecessors of state t are
+ * in_source      in_source[in_offset[t]] ... in_source[in_offset[t + 1] - 1].
+ *
+ * steps        : the number of dt decrements a timer starting at [timer] stays positive.
+ * transition   : the dwell step counters after moving from value u to value w, or false on a violation.
+ */
+
+class StateGraph {
+
+public:
+    explicit StateGraph(const ProblemConfig &config);
+    Solution solve(const RelaxedView &v_rel) const;
+    Policy policy(const RelaxedView &v_rel) const;
+    std::size_t size() const { return _state_value.size(); }
+    std::size_t edges() const { return _in_source.size(); }
+
+private:
+    const ProblemConfig &_dp;
+    std::size_t _slots{0};
+    std::size_t _n_init{0};
+
+    std::vector<ProblemConfig::disc_vector> _values;
+    std::vector<std::vector<char>> _feasible;
+    std::vector<int> _fresh;
+
+    std::vector<int> _state_value;
+    std::vector<int> _state_steps;
+    std::vector<std::uint32_t> _in_offset;
+    std::vector<std::uint32_t> _in_source;
+
+    int _steps(double timer) const;
+    bool _transition(const int *steps, int u, int w, int *next) const;
+};
+
+}
+#endif
@@ -0,0 +1,131 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#ifndef DPAPPROX_STRATEGIES_H
+#define DPAPPROX_STRATEGIES_H
+
+#include <cstddef>
+#include <cmath>
+#include "config.h"
+
+/*
+ * Native kernels of the built-in approximation strategies (see [ProblemConfig::Strategy] and docs/approximations.md),
+ * used by Solver in place of the callbacks. Each strategy has a fixed cost layout for [nv] inputs, and the same
+ * floating point operations as the callbacks of the examples, so both give identical results.
+ *
+ * dim()       : the size of the cost to go.
+ * stage_dim() : the size of the stage cost.
+ * stage()     : the stage cost [c] of value [v] at the relaxed column [r].
+ * initial()   : completes the cost to go of node 0 from its stage cost, already in [V].
+ * combine()   : the cost to go [out] of a label reached from a label with cost to go [V], with the stage cost [c],
+ *               the dwell penalty [d], and the state cost [p] of [np] elements (1 broadcasts).
+ * objective() : the objective of a cost to go.
+ *
+ * cost_dim()  : the size of the cost to go of [strategy], 0 for [Custom].
+ */
+
+namespace DPapprox::strategies {
+
+// the stage and running costs of the strategies that add up the deviation of each input.
+inline void deviation(const double *v, const double *r, std::size_t nv, double dt, double *c) {
+    for (std::size_t k = 0; k < nv; ++k)
+        c[k] = (v[k] - r[k]) * dt;
+}
+
+template<class Scalar>
+inline void accumulate(const Scalar *V, const double *c, double d, const double *p, std::size_t np, std::size_t n,
+                       double *out) {
+    for (std::size_t k = 0; k < n; ++k)
+        out[k] = static_cast<double>(V[k]) + ((c[k] + d) + p[np == 1 ? 0 : k]);
+}
+
+inline double inf_norm(const double *x, std::size_t n) {
+    double norm = 0;
+    for (std::size_t k = 0; k < n; ++k)
+        norm = std::abs(x[k]) > norm ? std::abs(x[k]) : norm;
+    return norm;
+}
+
+struct SimpleRounding {
+    static std::size_t dim(std::size_t) { return 1; }
+    static std::size_t stage_dim(std::size_t) { return 1; }
+    static void stage(const double *v, const double *r, std::size_t nv, double, double *c) {
+        c[0] = 0;
+        for (std::size_t k = 0; k < nv; ++k)
+            c[0] += std::abs(v[k] - r[k]);
+    }
+    static void initial(double *, std::size_t) {}
+    template<class Scalar>
+    static void combine(const Scalar *V, const double *c, double d, const double *p, std::size_t np, std::size_t,
+                        double *out) {
+        accumulate(V, c, d, p, np, 1, out);
+    }
+    static double objective(const double *x, std::size_t) { return x[0]; }
+};
+
+struct SumUp {
+    static std::size_t dim(std::size_t) { return 1; }
+    static std::size_t stage_dim(std::size_t) { return 1; }
+    static void stage(const double *v, const double *r, std::size_t, double dt, double *c) {
+        deviation(v, r, 1, dt, c);
+    }
+    static void initial(double *, std::size_t) {}
+    template<class Scalar>
+    static void combine(const Scalar *V, const double *c, double d, const double *p, std::size_t np, std::size_t,
+                        double *out) {
+        accumulate(V, c, d, p, np, 1, out);
+    }
+    static double objective(const double *x, std::size_t) { return std::abs(x[0]); }
+};
+
+struct SumUpInfNorm {
+    static std::size_t dim(std::size_t nv) { return nv; }
+    static std::size_t stage_dim(std::size_t nv) { return nv; }
+    static void stage(const double *v, const double *r, std::size_t nv, double dt, double *c) {
+        deviation(v, r, nv, dt, c);
+    }
+    static void initial(double *, std::size_t) {}
+    template<class Scalar>
+    static void combine(const Scalar *V, const double *c, double d, const double *p, std::size_t np, std::size_t nv,
+                        double *out) {
+        accumulate(V, c, d, p, np, nv, out);
+    }
+    static double objective(const double *x, std::size_t nv) { return inf_norm(x, nv); }
+};
+
+// the cost to go keeps the integrated deviation of every input, and the running maximum of its infinity norm last.
+struct CIA {
+    static std::size_t dim(std::size_t nv) { return nv + 1; }
+    static std::size_t stage_dim(std::size_t nv) { return nv; }
+    static void stage(const double *v, const double *r, std::size_t nv, double dt, double *c) {
+        deviation(v, r, nv, dt, c);
+    }
+    static void initial(double *V, std::size_t nv) { V[nv] = inf_norm(V, nv); }
+    template<class Scalar>
+    static void combine(const Scalar *V, const double *c, double d, const double *p, std::size_t np, std::size_t nv,
+                        double *out) {
+        accumulate(V, c, d, p, np, nv, out);
+        const double norm = inf_norm(out, nv), V_max = static_cast<double>(V[nv]);
+        out[nv] = (norm > V_max) ? norm : V_max;
+    }
+    static double objective(const double *x, std::size_t nv) { return x[nv]; }
+};
+
+inline std::size_t cost_dim(ProblemConfig::Strategy strategy, std::size_t nv) {
+    switch (strategy) {
+        case ProblemConfig::Strategy::SimpleRounding: return SimpleRounding::dim(nv);
+        case ProblemConfig::Strategy::SumUp: return SumUp::dim(nv);
+        case ProblemConfig::Strategy::SumUpInfNorm: return SumUpInfNorm::dim(nv);
+        case ProblemConfig::Strategy::CIA: return CIA::dim(nv);
+        default: return 0;
+    }
+}
+
+}
+#endif
@@ -15,6 +15,8 @@
 
 /*
  * overloading +, -, * for vectors.
+ * add : out = a + b with the same broadcasting rules as operator+, written into [out] without allocating once
+ *       [out] has the capacity.
  */
 
 namespace DPapprox {
@@ -23,5 +25,7 @@ std::vector<double> operator+(const std::vector<double>&, const std::vector<doub
 std::vector<double> operator-(const ProblemConfig::disc_vector&, const std::vector<double>&);
 std::vector<double> operator*(const std::vector<double>&, double);
 
+void add(const double *a, std::size_t na, const double *b, std::size_t nb, std::vector<double> &out);
+
 }
 #endif 
@@ -8,175 +8,1721 @@
  */
 
 #include "DPapprox.h"
+#include "state_graph.h"
+#include "strategies.h"
 #include "logger.h"
+#include <numeric>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <bit>
+#include <thread>
 
 namespace DPapprox {
 
-Solver::Solver(const std::vector<std::vector<double>> &_v_rel, const ProblemConfig &config)
-    : _v_rel(_v_rel), _dp(config)
+namespace {
+
+// a built-in strategy sets the callbacks to its kernels, which the engines other than the labels DP call. the
+// objectives of the scalar strategies are the ones the min-plus kernel recognizes.
+std::shared_ptr<const ProblemConfig> adapt_strategy(std::shared_ptr<const ProblemConfig> config) {
+    using Strategy = ProblemConfig::Strategy;
+    if (config->strategy == Strategy::Custom)
+        return config;
+    const std::size_t nv = config->v_feasible.empty() || config->v_feasible[0].empty()
+                           ? 0 : config->v_feasible[0][0].size();
+    if (config->strategy == Strategy::SumUp && nv != 1)
+        throw std::runtime_error("Error: the SumUp strategy requires a single input, use SumUpInfNorm.");
+
+    auto adapted = std::make_shared<ProblemConfig>(*config);
+    adapted->stage_cost_into = adapted->custom_cost_into = {};
+    adapted->customize = false;
+    adapted->custom_cost = ProblemConfig::default_custom_cost;
+    auto stage = [](auto kernel) {
+        return [](const ProblemConfig::disc_vector &v, const std::vector<double> &r, int, double dt) {
+            std::vector<double> c(decltype(kernel)::stage_dim(v.size()));
+            decltype(kernel)::stage(v.data(), r.data(), v.size(), dt, c.data());
+            return c;
+        };
+    };
+    adapted->objective_kind = ProblemConfig::ObjectiveKind::Custom;
+    switch (config->strategy) {
+        case Strategy::SimpleRounding:
+            adapted->stage_cost = stage(strategies::SimpleRounding{});
+            adapted->objective = ProblemConfig::default_objective;
+            adapted->objective_kind = ProblemConfig::ObjectiveKind::Identity;
+            break;
+        case Strategy::SumUp:
+            adapted->stage_cost = stage(strategies::SumUp{});
+            adapted->objective = ProblemConfig::abs_objective;
+            adapted->objective_kind = ProblemConfig::ObjectiveKind::Absolute;
+            break;
+        case Strategy::SumUpInfNorm:
+            adapted->stage_cost = stage(strategies::SumUpInfNorm{});
+            adapted->objective = [](const std::vector<double> &x) {
+                return strategies::SumUpInfNorm::objective(x.data(), x.size());
+            };
+            break;
+        default:
+            // the cost to go of node 0 is the stage cost, its norm is appended by the first custom cost.
+            adapted->stage_cost = stage(strategies::CIA{});
+            adapted->objective = [](const std::vector<double> &x) { return x.back(); };
+            adapted->customize = true;
+            adapted->custom_cost = [nv](std::vector<double> &V, std::vector<double> &cost_nxt, int, double) {
+                std::vector<double> out(nv + 1);
+                for (std::size_t k = 0; k < nv; ++k)
+                    out[k] = V[k] + cost_nxt[k];
+                const double norm = strategies::inf_norm(out.data(), nv);
+                const double V_max = (V.size() > nv) ? V[nv] : strategies::inf_norm(V.data(), nv);
+                out[nv] = (norm > V_max) ? norm : V_max;
+                return out;
+            };
+            break;
+    }
+    return adapted;
+}
+
+// reports a phase of the labels DP to the phase callback for the lifetime of the scope.
+class PhaseScope {
+public:
+    PhaseScope(const ProblemConfig &dp, ProblemConfig::Phase phase) : _dp(dp), _phase(phase) {
+        if (_dp.phase_callback)
+            _dp.phase_callback(_phase, true);
+    }
+    ~PhaseScope() {
+        if (_dp.phase_callback)
+            _dp.phase_callback(_phase, false);
+    }
+
+private:
+    const ProblemConfig &_dp;
+    ProblemConfig::Phase _phase;
+};
+
+// the span callbacks are adapted to their vector forms, which the engines other than the labels DP call.
+std::shared_ptr<const ProblemConfig> adapt_spans(std::shared_ptr<const ProblemConfig> config) {
+    if (!config->stage_cost_into && !config->state_transition_into && !config->state_cost_into &&
+        !config->custom_cost_into)
+        return config;
+
+    auto adapted = std::make_shared<ProblemConfig>(*config);
+    if (auto f = config->stage_cost_into)
+        adapted->stage_cost = [f, dim = config->cost_dim](const ProblemConfig::disc_vector &v,
+                                                           const std::vector<double> &r, int i, double dt) {
+            std::vector<double> out(dim);
+            f(v, r, i, dt, out);
+            return out;
+        };
+    if (auto f = config->state_transition_into)
+        adapted->state_transition = [f](const ProblemConfig::traj_vector &x, const ProblemConfig::disc_vector &v,
+                                        int i, double dt) {
+            ProblemConfig::traj_vector out(x.size());
+            f(x, v, i, dt, out);
+            return out;
+        };
+    if (auto f = config->state_cost_into)
+        adapted->state_cost = [f, dim = config->state_cost_dim](const ProblemConfig::traj_vector &x,
+                                                                 const std::vector<double> &r, int i, double dt) {
+            std::vector<double> out(dim);
+            f(x, r, i, dt, out);
+            return out;
+        };
+    if (auto f = config->custom_cost_into)
+        adapted->custom_cost = [f, dim = config->cost_dim](std::vector<double> &V, std::vector<double> &cost_nxt,
+                                                            int i, double dt) {
+            std::vector<double> out(dim);
+            f(V, cost_nxt, i, dt, out);
+            return out;
+        };
+    return adapted;
+}
+
+// scenario bundles go through the state callbacks of the problem, so both engines carry them unchanged.
+std::shared_ptr<const ProblemConfig> bundle_scenarios(std::shared_ptr<const ProblemConfig> config) {
+    if (config->scenarios == 0)
+        return config;
+    if (!config->include_state || !config->scenario_transition || !config->scenario_cost)
+        throw std::runtime_error("Error: scenarios require include_state, scenario_transition and scenario_cost.");
+
+    auto bundled = std::make_shared<ProblemConfig>(*config);
+    const std::size_t S = config->scenarios;
+    const std::size_t nx = config->x0.size();
+    bundled->x0.resize(nx * S);
+    for (std::size_t r = 0; r < nx; ++r)
+        std::fill_n(bundled->x0.begin() + r * S, S, config->x0[r]);
+
+    bundled->state_transition = config->scenario_transition;
+    bundled->state_transition_into = {};
+    bundled->state_cost_into = {};
+    bundled->state_cost = [cost = config->scenario_cost, aggregate = config->scenario_aggregate, S](
+            const ProblemConfig::bundle_vector &x, const std::vector<double> &ri, int i, double dt) {
+        std::vector<double> c = cost(x, ri, i, dt);
+        if (c.size() % S != 0)
+            throw std::runtime_error("Error: scenario_cost must return a cost for every scenario.");
+        std::vector<double> out(c.size() / S);
+        for (std::size_t e = 0; e < out.size(); ++e) {
+            auto first = c.begin() + e * S;
+            if (aggregate == ProblemConfig::Aggregate::Max)
+                out[e] = *std::max_element(first, first + S);
+            else
+                out[e] = std::accumulate(first, first + S, 0.0) / S;
+        }
+        return out;
+    };
+    return bundled;
+}
+
+// an adjacency list is resolved into a relation on values, so that it holds for any feasible sets.
+std::shared_ptr<const ProblemConfig> resolve_transitions(std::shared_ptr<const ProblemConfig> config) {
+    if (config->transitions.empty())
+        return config;
+    const auto &values = config->v_feasible.at(0);
+    if (config->transitions.size() != values.size())
+        throw std::runtime_error("Error: transitions must have one entry per value of v_feasible[0].");
+
+    std::set<std::pair<ProblemConfig::disc_vector, ProblemConfig::disc_vector>> pairs;
+    for (std::size_t a = 0; a < values.size(); ++a)
+        for (std::size_t b: config->transitions[a])
+            pairs.emplace(values[a], values.at(b));
+    std::set<ProblemConfig::disc_vector> listed(values.begin(), values.end());
+
+    auto resolved = std::make_shared<ProblemConfig>(*config);
+    resolved->transitions.clear();
+    resolved->allowed_transition = [pairs = std::move(pairs), listed = std::move(listed),
+                                    allowed = config->allowed_transition](const ProblemConfig::disc_vector &from,
+                                                                          const ProblemConfig::disc_vector &to) {
+        if (allowed && !allowed(from, to))
+            return false;
+        return !listed.count(from) || !listed.count(to) || pairs.count({from, to}) > 0;
+    };
+    return resolved;
+}
+
+}
+
+template<class Scalar>
+BasicSolver<Scalar>::BasicSolver(const std::vector<std::vector<double>> &v_rel, const ProblemConfig &config,
+               std::pmr::memory_resource *resource)
+    : BasicSolver(RelaxedView(), std::make_shared<const ProblemConfig>(config), resource)
+{
+    reset(v_rel);
+}
+
+template<class Scalar>
+BasicSolver<Scalar>::BasicSolver(const RelaxedView &v_rel, const ProblemConfig &config,
+                                 std::pmr::memory_resource *resource)
+    : BasicSolver(v_rel, std::make_shared<const ProblemConfig>(config), resource) {}
+
+template<class Scalar>
+BasicSolver<Scalar>::BasicSolver(const RelaxedView &v_rel, std::shared_ptr<const ProblemConfig> config,
+               std::pmr::memory_resource *resource)
+    : _config(resolve_transitions(bundle_scenarios(adapt_spans(adapt_strategy(std::move(config)))))),
+      _dp(*_config), _v_rel(v_rel),
+      _resource(resource ? resource : _make_arena()),
+      _offset(_resource), _dim(_resource), _cost_offset(_resource), _cost_to_go(_resource), _path_to_go(_resource),
+      _reached(_resource), _timers(_resource), _next_state(_resource),
+      _transition_memo(_resource), _state_cost_memo(_resource),
+      _c(_resource), _pen(_resource), _best(_resource), _locked(_resource), _dwell(_resource), _dwell_opt(_resource),
+      _arg(_resource),
+      _allowed_offset(_resource), _allowed_source(_resource)
 {
     DPapprox::Log.log(INFO) << "Initializing Solver." << std::endl;
 
-    if (_dp.N != static_cast<int>(_v_rel[0].size()))
+    if (_dp.k_best < 1)
+        throw std::runtime_error("Error: k_best must be positive.");
+
+    if (_v_rel.rows() > 0 && _dp.N != static_cast<int>(_v_rel.cols()))
         throw std::runtime_error("Error: N does not match _v_rel[0].size().");
 }
 
-void Solver::solve() {
+template<class Scalar>
+BasicSolver<Scalar>::~BasicSolver() = default;
+
+template<class Scalar>
+void BasicSolver<Scalar>::reset(const std::vector<std::vector<double>> &v_rel) {
+    // the copy reuses the storage of the previous relaxed solution.
+    _owned_v_rel.resize(v_rel.size());
+    for (std::size_t r = 0; r < v_rel.size(); ++r)
+        _owned_v_rel[r].assign(v_rel[r].begin(), v_rel[r].end());
+    reset(RelaxedView(_owned_v_rel));
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::reset(const RelaxedView &v_rel) {
+    if (_dp.N != static_cast<int>(v_rel.cols()))
+        throw std::runtime_error("Error: N does not match _v_rel[0].size().");
+    _v_rel = v_rel;
+    _valid_nodes = 0;
+    _state_cost_memo.clear();
+    solution = Solution{};
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::update(const std::vector<std::vector<double>> &v_rel, int first_changed) {
+    if (first_changed < 0)
+        throw std::runtime_error("Error: first_changed must not be negative.");
+    const int valid = std::min(_valid_nodes, first_changed);
+    reset(v_rel);
+    _valid_nodes = valid;
+    solve();
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::update(const RelaxedView &v_rel, int first_changed) {
+    if (first_changed < 0)
+        throw std::runtime_error("Error: first_changed must not be negative.");
+    const int valid = std::min(_valid_nodes, first_changed);
+    reset(v_rel);
+    _valid_nodes = valid;
+    solve();
+}
+
+Solution::Status interruption(const ProblemConfig &config) {
+    if (config.cancel && config.cancel->load(std::memory_order_relaxed))
+        return Solution::Status::Cancelled;
+    if (config.deadline != std::chrono::steady_clock::time_point::max() &&
+        std::chrono::steady_clock::now() >= config.deadline)
+        return Solution::Status::Deadline;
+    return Solution::Status::Solved;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::solve() {
     DPapprox::Log.log(INFO) << "Solving..." << std::endl;
-    _set_timers(); // initialize timers for dwell time constraints.
 
-    std::pair<ProblemConfig::disc_vector, int> v_ini, v_now, v_nxt;
-    std::vector<double> opt, c{0}, V{0}, p{0}, d{0}, cost_nxt{0}, cost{0};
-    ProblemConfig::traj_vector xni{_dp.x0};
-    std::vector<std::vector<double>> dwell;
-    dwell.resize(_dp.dwell_time_cons.size());
+    solutions.clear();
+    _start = std::chrono::steady_clock::now();
+    _reported = 0;
+    _progress.running.store(true, std::memory_order_relaxed);
+    _publish(-1, INFTY.at(0), false);
+    if (_separable()) {
+        _solve_separable();
+    } else if (_dp.multires_factor > 1) {
+        _solve_multires();
+    } else if (_dp.coarsen_tolerance >= 0) {
+        _solve_coarse();
+    } else {
+        if (_dp.engine == ProblemConfig::Engine::StateGraph) {
+            if (!_graph)
+                _graph = std::make_unique<StateGraph>(_dp);
+            solution = _graph->solve(_v_rel);
+        } else {
+            _solve_labels();
+        }
+        if (solution.status != Solution::Status::Solved)
+            _fallback();
+    }
+    _publish(solution.last_node, solution.objective, true);
+    _progress.running.store(false, std::memory_order_relaxed);
+
+    if (solution.success)
+        DPapprox::Log.log(INFO) << "Solved." << std::endl;
+    else if (solution.status == Solution::Status::Cancelled || solution.status == Solution::Status::Deadline)
+        DPapprox::Log.log(INFO) << "Stopped at node " << solution.last_node << "." << std::endl;
+    else
+        DPapprox::Log.log(INFO) << "Something went wrong!" << std::endl;
+}
+
+template<class Scalar>
+std::future<Solution> BasicSolver<Scalar>::solve_async() {
+    return std::async(std::launch::async, [this] {
+        solve();
+        return solution;
+    });
+}
+
+template<class Scalar>
+Policy BasicSolver<Scalar>::policy() {
+    if (_dp.include_state || _dp.customize)
+        throw std::runtime_error("Error: a policy requires a problem without include_state and customize.");
+    if (!_graph)
+        _graph = std::make_unique<StateGraph>(_dp);
+    return _graph->policy(_v_rel);
+}
+
+template<class Scalar>
+const Progress &BasicSolver<Scalar>::progress() const {
+    return _progress;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_publish(int stage, double objective, bool last) {
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    _progress.stage.store(stage, std::memory_order_relaxed);
+    _progress.objective.store(objective, std::memory_order_relaxed);
+    _progress.elapsed.store(elapsed, std::memory_order_relaxed);
+    if (_dp.progress_callback && (last || elapsed - _reported >= _dp.progress_interval)) {
+        _reported = elapsed;
+        _dp.progress_callback(stage, objective, elapsed);
+    }
+}
 
+template<class Scalar>
+Plan BasicSolver<Scalar>::plan(const ProblemConfig &config, std::size_t rows, std::size_t cols) {
+    auto dp = resolve_transitions(bundle_scenarios(adapt_spans(adapt_strategy(
+            std::make_shared<const ProblemConfig>(config)))));
+    if (dp->N != static_cast<int>(cols))
+        throw std::runtime_error("Error: N does not match _v_rel[0].size().");
+    if (dp->k_best < 1)
+        throw std::runtime_error("Error: k_best must be positive.");
+    return _plan_of(*dp, rows);
+}
+
+template<class Scalar>
+Plan BasicSolver<Scalar>::_plan_of(const ProblemConfig &dp, std::size_t rows) {
+    // the modes are checked in the order of solve(), and a Solver of any mode allocates its own arena.
+    const std::size_t nv = dp.v_feasible[0][0].size();
+    const std::size_t arena = _estimate(dp, nv).peak_bytes + 4096;
+    auto add = [](Plan &plan, const Plan &inner) {
+        plan.labels += inner.labels;
+        plan.transitions += inner.transitions;
+        plan.table_bytes += inner.table_bytes;
+        plan.path_bytes += inner.path_bytes;
+        plan.path_spilled = plan.path_spilled || inner.path_spilled;
+        plan.workspace_bytes += inner.workspace_bytes;
+        plan.peak_bytes += inner.peak_bytes;
+    };
+
+    if (_decomposes(dp, rows)) {
+        Plan plan{Plan::Mode::Separable};
+        for (std::size_t d = 0; d < nv; ++d)
+            add(plan, _plan_of(*_part(dp, d), 1));
+        plan.peak_bytes += arena;
+        return plan;
+    }
+    if (dp.multires_factor > 1) {
+        const int F = dp.multires_factor, K = (dp.N + F - 1) / F;
+        ProblemConfig coarse = dp, fine = dp;
+        coarse.N = K;
+        coarse.dt = F * dp.dt;
+        coarse.multires_factor = 0;
+        coarse.k_best = 1;
+        coarse.v_feasible.resize(K);
+        for (int k = 0; k < K; ++k)
+            coarse.v_feasible[k] = dp.v_feasible[k * F];
+        fine.multires_factor = 0;
+        Plan plan{Plan::Mode::Multiresolution};
+        add(plan, _plan_of(coarse, rows));
+        add(plan, _plan_of(fine, rows));
+        plan.peak_bytes += arena;
+        return plan;
+    }
+    if (dp.coarsen_tolerance >= 0) {
+        ProblemConfig reduced = dp;
+        reduced.coarsen_tolerance = -1;
+        reduced.k_best = 1;
+        Plan plan{Plan::Mode::Coarsened};
+        add(plan, _plan_of(reduced, rows));
+        plan.peak_bytes += arena;
+        return plan;
+    }
+
+    const std::size_t dim = (dp.strategy != ProblemConfig::Strategy::Custom)
+                            ? strategies::cost_dim(dp.strategy, nv)
+                            : dp.stage_cost(dp.v_feasible[0][0], std::vector<double>(rows, 0.0), 0, dp.dt).size();
+    const std::size_t nx = dp.include_state ? dp.x0.size() : 0;
+    const std::size_t slots = dp.dwell_time_cons.size() * nv;
+    if (dp.engine == ProblemConfig::Engine::StateGraph) {
+        // the graph holds the value and step counters of every state and the transitions, the DP two layers of
+        // labels and a predecessor per state and node.
+        StateGraph graph(dp);
+        const std::size_t S = graph.size(), E = graph.edges();
+        Plan plan{Plan::Mode::StateGraph};
+        plan.labels = dp.N * S;
+        plan.transitions = (dp.N - 1) * E;
+        plan.table_bytes = S * (1 + slots) * sizeof(int) + (S + 1 + E) * sizeof(std::uint32_t)
+                           + 2 * S * (dim * sizeof(double) + nx * sizeof(double) + sizeof(char));
+        plan.path_bytes = dp.N * S * sizeof(std::int32_t);
+        plan.workspace_bytes = S * (nv + dim) * sizeof(double);
+        plan.peak_bytes = arena + plan.table_bytes + plan.path_bytes + plan.workspace_bytes;
+        return plan;
+    }
+
+    // the labels DP relaxes every allowed pair of values, and the arena takes the tables when it was sized for costs
+    // as large as theirs.
+    Plan plan = _estimate(dp, dim);
+    kernels::MinPlusOp op;
+    plan.mode = _min_plus_op(dp, dim, op) ? Plan::Mode::MinPlus : Plan::Mode::Labels;
+    std::size_t pairs = 0;
+    for (int i = 0; i + 1 < dp.N; ++i) {
+        const auto &preds = dp.v_feasible[i], &succs = dp.v_feasible[i + 1];
+        const bool same = i > 0 && preds == dp.v_feasible[i - 1] && succs == preds;
+        if (!same) {
+            pairs = dp.allowed_transition ? 0 : preds.size() * succs.size();
+            for (std::size_t k = 0; dp.allowed_transition && k < preds.size(); ++k)
+                for (const ProblemConfig::disc_vector &w: succs)
+                    pairs += dp.allowed_transition(preds[k], w) ? 1 : 0;
+        }
+        plan.transitions += pairs;
+    }
+    if (dp.include_state && dp.memo_capacity > 0) {
+        const std::size_t entries = std::bit_ceil(std::max(dp.memo_capacity, MemoCache::PROBES));
+        plan.workspace_bytes += entries * (2 * (nx + 2) * sizeof(std::int64_t) + (nx + dim) * sizeof(double));
+    }
+    const std::size_t tables = plan.table_bytes + (plan.path_spilled ? 0 : plan.path_bytes) + plan.workspace_bytes;
+    plan.peak_bytes = (tables + 4096 <= arena) ? arena : arena + tables;
+    return plan;
+}
+
+// the stage costs of value j at node i are cost[first[offset[i] + j]] ... cost[first[offset[i] + j + 1] - 1].
+template<class Scalar>
+struct BasicSolver<Scalar>::StageTable {
+    std::vector<std::size_t> offset;
+    std::vector<std::size_t> first;
+    std::vector<double> cost;
+};
+
+template<class Scalar>
+Sweep BasicSolver<Scalar>::sweep(const RelaxedView &v_rel, const ProblemConfig &config,
+                                 const std::vector<Variant> &variants, unsigned threads) {
+    // the stage costs only depend on the values and the relaxed solution, so a Solver without tables computes them
+    // once for all variants.
+    BasicSolver probe(v_rel, config, std::pmr::new_delete_resource());
+    if (config.strategy != ProblemConfig::Strategy::Custom)
+        for (const Variant &variant: variants)
+            if (variant.objective)
+                throw std::runtime_error("Error: a sweep variant cannot replace the objective of a built-in strategy.");
+    auto table = std::make_shared<StageTable>();
+    const int N = probe._dp.N;
+    table->offset.assign(N + 1, 0);
+    table->first.push_back(0);
+    for (int i = 0; i < N; ++i) {
+        const auto &values = probe._dp.v_feasible[i];
+        table->offset[i + 1] = table->offset[i] + values.size();
+        probe._v_rel.column(i, probe._col);
+        for (const ProblemConfig::disc_vector &v: values) {
+            probe._stage_cost(v, probe._col, i, probe._stage);
+            table->cost.insert(table->cost.end(), probe._stage.begin(), probe._stage.end());
+            table->first.push_back(table->cost.size());
+        }
+    }
+
+    // every worker takes the next variant, and solves it with a Solver of its own on the borrowed [v_rel] and the
+    // shared stage costs.
+    Sweep result;
+    result.solutions.resize(variants.size());
+    result.summary.resize(variants.size());
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        for (std::size_t k = next++; k < variants.size(); k = next++) {
+            auto variant = std::make_shared<ProblemConfig>(config);
+            if (variants[k].dwell_time_cons)
+                variant->dwell_time_cons = *variants[k].dwell_time_cons;
+            if (variants[k].dwell_time_init)
+                variant->dwell_time_init = *variants[k].dwell_time_init;
+            if (variants[k].objective) {
+                variant->objective = variants[k].objective;
+                variant->objective_kind = ProblemConfig::ObjectiveKind::Auto;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            BasicSolver solver(v_rel, std::shared_ptr<const ProblemConfig>(variant));
+            solver._stages = table;
+            solver.solve();
+            Solution &solution = result.solutions[k] = std::move(solver.solution);
+
+            SweepRow &row = result.summary[k];
+            row.variant = k;
+            row.objective = solution.objective;
+            row.success = solution.success;
+            row.status = solution.status;
+            for (std::size_t i = 1; i < solution.optimum_path.size(); ++i)
+                row.switches += (solution.optimum_path[i] != solution.optimum_path[i - 1]);
+            row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, variants.size()));
+    std::vector<std::future<void>> jobs;
+    for (unsigned t = 1; t < threads; ++t)
+        jobs.push_back(std::async(std::launch::async, work));
+    work();
+    for (auto &job: jobs)
+        job.get();
+    return result;
+}
+
+std::ostream &operator<<(std::ostream &os, const Sweep &sweep) {
+    static const char *status[] = {"Solved", "Infeasible", "Cancelled", "Deadline"};
+    os << "variant objective success status switches seconds\n";
+    for (const SweepRow &row: sweep.summary)
+        os << row.variant << " " << row.objective << " " << row.success << " "
+           << status[static_cast<int>(row.status)] << " " << row.switches << " " << row.seconds << "\n";
+    return os;
+}
+
+template<class Scalar>
+MemoStats BasicSolver<Scalar>::memo_stats() const {
+    const MemoStats &t = _transition_memo.stats(), &c = _state_cost_memo.stats();
+    return MemoStats{t.hits + c.hits, t.misses + c.misses, t.evictions + c.evictions};
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_solve_labels() {
     const int N = _dp.N;
+    const std::size_t nv = _dp.v_feasible[0][0].size();
+    const std::size_t nx = _dp.x0.size();
+    std::optional<PhaseScope> phase(std::in_place, _dp, ProblemConfig::Phase::Setup);
+
+    // the labels of the nodes before [valid_nodes] only depend on relaxed columns that did not change, so they are
+    // kept, and the DP restarts with the stage into the first changed node.
+    const int first = std::min(_valid_nodes, N);
+    if (first > 0)
+        _truncate_tables(first);
+    else
+        _reset_tables();
 
-    // calculate the initial cost to go at v_0.
-    for (auto const& v_0: _dp.v_feasible[0]) {
-        v_ini = {v_0, 0};
-        _cost_to_go[v_ini] = _dp.stage_cost(v_0, get_column(_v_rel, 0), 0, _dp.dt);
-        if (_dp.include_state) _next_state[v_ini] = _dp.state_transition(_dp.x0, v_0, 0, _dp.dt);
+    // calculate the initial cost to go at v_0, and initialize timers for dwell time constraints.
+    _v_rel.column(0, _col);
+    for (std::size_t j = 0; first == 0 && j < _dp.v_feasible[0].size(); ++j) {
+        const ProblemConfig::disc_vector &v_0 = _dp.v_feasible[0][j];
+        const std::size_t label = j;
+        _stage_cost_at(0, j, _col, _stage);
+        if (_dp.strategy == ProblemConfig::Strategy::CIA) {
+            _stage.resize(nv + 1);
+            strategies::CIA::initial(_stage.data(), nv);
+        }
+        _store_cost(0, label, _stage);
+        _reached[label] = 1;
+        for (std::size_t k = 0; k < _dp.dwell_time_cons.size(); ++k)
+            for (std::size_t idx = 0; idx < nv; ++idx)
+                _timers[label * _slots + k * nv + idx] =
+                        _dp.dwell_time_init.empty() ? 0.0 : _dp.dwell_time_init[k].at(idx);
+        if (!_hold.empty())
+            _run_down(_timers.data() + label * _slots, _hold[0]);
+        if (_dp.include_state)
+            _state_transition(_dp.x0.data(), v_0, 0, j, _next_state.data() + label * nx);
+    }
+
+    // scalar costs with an identity or absolute value objective are relaxed by the min-plus kernel.
+    kernels::MinPlusOp op;
+    const bool min_plus = _min_plus_op(_dp, _dim[0], op);
+    if (min_plus)
+        DPapprox::Log.log(DEBUG) << "Using min-plus kernel." << std::endl;
+
+    // the other built-in strategies are relaxed by their native kernels, the custom ones by the callbacks.
+    bool (BasicSolver::*relax)(int) = &BasicSolver::_relax;
+    switch (_dp.strategy) {
+        case ProblemConfig::Strategy::SimpleRounding:
+            relax = &BasicSolver::template _relax_native<strategies::SimpleRounding>;
+            break;
+        case ProblemConfig::Strategy::SumUp:
+            relax = &BasicSolver::template _relax_native<strategies::SumUp>;
+            break;
+        case ProblemConfig::Strategy::SumUpInfNorm:
+            relax = &BasicSolver::template _relax_native<strategies::SumUpInfNorm>;
+            break;
+        case ProblemConfig::Strategy::CIA:
+            relax = &BasicSolver::template _relax_native<strategies::CIA>;
+            break;
+        default:
+            break;
     }
 
     // DP has 3 loops: over time discretization nodes (N), feasible v at i + 1, and feasible v at i.
-    for (int i = 0; i < N - 1; ++i) {
-        for (auto const& vni: _dp.v_feasible[i + 1]) {
-            v_nxt = {vni, i + 1}; // keys used in maps.
-
-            opt = {std::numeric_limits<double>::infinity()}; // initialize optimal value at infinity.
-            c = _dp.stage_cost(vni, get_column(_v_rel, i+1), i + 1, _dp.dt); // stage cost at i + 1.
-            for (auto const& vi: _dp.v_feasible[i]) {
-                v_now = {vi, i};
-
-                // check for dwell time violations. if there are any DWELL_FLAG is inserted.
-                for (size_t k = 0; k < _dp.dwell_time_cons.size(); ++k) {
-                    dwell[k] = _dwell_time(_dp.dwell_time_cons[k], _timers[k].at(v_now), vi, vni, i);
-                }
-                // check if there is any DWELL_FLAG
-                bool violate_dwell = std::any_of(dwell.begin(), dwell.end(), [](const std::vector<double> &row) {
-                    return std::find(row.begin(), row.end(), DWELL_FLAG) != row.end();
-                });
-                // if DWELL_FLAG is found, set d cost to infinity.
-                d = {0};
-                if (violate_dwell)
-                    d = INFTY;
-
-                // if states are included, calculate state cost p.
-                if (_dp.include_state) {
-                    xni = _next_state.at(v_now);
-                    p = _dp.state_cost(xni, get_column(_v_rel, i), i, _dp.dt);
-                }
+    // cancellation and the deadline are checked between stages, and a stage where all labels hit INFTY ends the DP.
+    Solution::Status status = Solution::Status::Solved;
+    int last = N - 1;
+    phase.reset();
+    phase.emplace(_dp, ProblemConfig::Phase::Relax);
+    for (int i = std::max(first - 1, 0); i < N - 1; ++i) {
+        status = interruption(_dp);
+        if (status != Solution::Status::Solved) {
+            last = i;
+            break;
+        }
+        if (!(min_plus ? _relax_min_plus(i, op) : (this->*relax)(i))) {
+            status = Solution::Status::Infeasible;
+            last = i + 1;
+            break;
+        }
+        _publish(i, _frontier, false);
+    }
+    _valid_nodes = last + 1;
+    phase.reset();
+    phase.emplace(_dp, ProblemConfig::Phase::Backtrack);
 
-                V = _cost_to_go.at(v_now); // cost to go from v_i.
-                cost_nxt = (c + d + p);
-                // the total cost is V + cost of the next stage. user can customize the total cost by custom_cost.
-                if (!_dp.customize)
-                    cost = V + cost_nxt;
-                else
-                    cost = _dp.custom_cost(V, cost_nxt, i, _dp.dt);
-				
-                // the minimum objective is selected, and the values are written for cost to go, path to go, and timers.
-                if (_dp.objective(cost) < _dp.objective(opt)) {
-
-                    opt = cost;
-                    _cost_to_go[v_nxt] = opt;
-                    _path_to_go[v_nxt] = vi;
-
-                    if (_dp.include_state)
-                        _next_state[v_nxt] = _dp.state_transition(xni, vni, i + 1, _dp.dt);
-
-                    for (size_t k = 0; k < dwell.size(); ++k) {
-                        auto &timer = _timers[k];
-                        auto &dw = dwell[k];
-                        timer[v_nxt] = dw;
-                    }
+    // find the minimum cost to go at the last node, the first label wins ties.
+    std::int64_t j_end = -1;
+    double objective_end = 0;
+    for (std::size_t j = 0; j < _offset[last + 1] - _offset[last]; ++j) {
+        if (!_reached[_offset[last] + j])
+            continue;
+        auto first = _cost_to_go.begin() + _cost_offset[last] + j * _dim[last];
+        _V.assign(first, first + _dim[last]);
+        const double objective = _dp.objective(_V);
+        if (j_end < 0 || objective < objective_end) {
+            j_end = static_cast<std::int64_t>(j);
+            objective_end = objective;
+            _opt = _V;
+        }
+    }
+
+    solution = Solution{{}, {}, INFTY, _dp.objective(INFTY), false, status, last};
+    if (j_end < 0) {
+        solution.status = Solution::Status::Infeasible;
+        solution.last_node = -1;
+        return;
+    }
+
+    // backward recursion to calculate optimum path and traj
+    _backtrack(last, static_cast<std::size_t>(j_end), solution.optimum_path);
+
+    // save in solution
+    solution.cost = _opt;
+    solution.objective = objective_end;
+    solution.success = (solution.objective < INFTY.at(0));
+    if (status == Solution::Status::Solved && !solution.success)
+        solution.status = Solution::Status::Infeasible;
+    if (solution.status != Solution::Status::Solved)
+        return;
+
+    // the traj keeps its established layout: x0, the state at <v_0, 0>, then the state at <v_{i - 1}, i>.
+    if (_dp.include_state) {
+        solution.optimum_traj.reserve(N + 1);
+        solution.optimum_traj.push_back(_dp.x0);
+        for (int i = 0; i < N; ++i) {
+            const ProblemConfig::disc_vector &v = solution.optimum_path[i > 0 ? i - 1 : 0];
+            auto it = std::find(_dp.v_feasible[i].begin(), _dp.v_feasible[i].end(), v);
+            const std::size_t label = _offset[i] + std::distance(_dp.v_feasible[i].begin(), it);
+            if (it == _dp.v_feasible[i].end() || !_reached[label]) {
+                solution.optimum_traj.emplace_back();
+                continue;
+            }
+            auto first = _next_state.begin() + label * nx;
+            solution.optimum_traj.emplace_back(first, first + nx);
+        }
+    }
+
+    // the runners-up are enumerated from the tables.
+    if (_dp.k_best > 1)
+        _enumerate();
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_backtrack(int last, std::size_t label, std::vector<ProblemConfig::disc_vector> &path) const {
+    std::vector<std::size_t> index(last + 1);
+    index[last] = label;
+    for (auto i = last; i > 0; --i)
+        index[i - 1] = _path_to_go.get(i, index[i]);
+
+    path.reserve(_dp.N);
+    for (int i = 0; i <= last; ++i)
+        path.push_back(_dp.v_feasible[i][index[i]]);
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_enumerate() {
+    const int N = _dp.N;
+    _ranked.clear();
+    solutions.reserve(_dp.k_best);
+    solutions.push_back(solution);
+
+    // every runner-up is walked back from the end through the paths it extends, and its traj is replayed along it.
+    for (std::size_t r = 1; r < static_cast<std::size_t>(_dp.k_best) && _find_ranked(N, 0, r); ++r) {
+        const Ranked &end = _ranked_label(N, 0).paths[r];
+        Solution &s = solutions.emplace_back(Solution{{}, {}, end.cost, end.objective, true, solution.status,
+                                                      solution.last_node});
+        s.optimum_path.resize(N);
+        std::size_t j = end.from, rank = end.rank;
+        for (int i = N - 1; i >= 0; --i) {
+            s.optimum_path[i] = _dp.v_feasible[i][j];
+            const Ranked &path = _ranked_label(i, j).paths[rank];
+            j = path.from;
+            rank = path.rank;
+        }
+    }
+    _ranked.clear();
+
+    // the objectives of the enumeration are exact for additive costs only, so the solutions are ranked again.
+    std::stable_sort(solutions.begin(), solutions.end(),
+                     [](const Solution &a, const Solution &b) { return a.objective < b.objective; });
+    for (std::size_t r = 0; r < solutions.size(); ++r) {
+        Solution &s = solutions[r];
+        if (!_dp.include_state || !s.optimum_traj.empty())
+            continue;
+        s.optimum_traj.reserve(N + 1);
+        s.optimum_traj.push_back(_dp.x0);
+        for (int i = 0; i < N; ++i)
+            s.optimum_traj.push_back(_dp.state_transition(s.optimum_traj.back(), s.optimum_path[i], i, _dp.dt));
+    }
+    solution = solutions[0];
+}
+
+template<class Scalar>
+typename BasicSolver<Scalar>::RankedLabel &BasicSolver<Scalar>::_ranked_label(int i, std::size_t j) {
+    const std::size_t key = (i == _dp.N) ? _offset[i] : _offset[i] + j;
+    auto [it, inserted] = _ranked.try_emplace(key);
+    RankedLabel &label = it->second;
+    if (!inserted || i == _dp.N)
+        return label;
+
+    // the first path into a label is the one of the tables.
+    if (!_reached[key]) {
+        label.exhausted = true;
+        return label;
+    }
+    const std::size_t nx = _dp.x0.size();
+    Ranked &path = label.paths.emplace_back();
+    auto cost = _cost_to_go.begin() + _cost_offset[i] + j * _dim[i];
+    path.cost.assign(cost, cost + _dim[i]);
+    path.objective = _dp.objective(path.cost);
+    path.from = (i > 0) ? _path_to_go.get(i, j) : 0;
+    path.rank = 0;
+    path.timers.assign(_timers.begin() + key * _slots, _timers.begin() + (key + 1) * _slots);
+    if (_dp.include_state)
+        path.state.assign(_next_state.begin() + key * nx, _next_state.begin() + (key + 1) * nx);
+    return label;
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_find_ranked(int i, std::size_t j, std::size_t r) {
+    // the candidates of a label wait for the paths into their predecessors, which are found first on the stack.
+    struct Frame {
+        int i;
+        std::size_t j, r;
+    };
+    std::vector<Frame> stack{{i, j, r}};
+    // the heap pops the lowest objective, then the lowest predecessor and rank, so the first one wins ties.
+    auto later = [](const Ranked &a, const Ranked &b) {
+        return std::tie(a.objective, a.from, a.rank) > std::tie(b.objective, b.from, b.rank);
+    };
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        RankedLabel &label = _ranked_label(frame.i, frame.j);
+        if (label.paths.size() > frame.r || label.exhausted) {
+            stack.pop_back();
+            continue;
+        }
+
+        // every reached predecessor gives a candidate, the one of the first path gives its second path.
+        if (!label.initialized) {
+            label.initialized = true;
+            const int n = frame.i;
+            if (n > 0) {
+                const bool sparse = n < _dp.N && _allowed(n - 1);
+                const std::size_t first = sparse ? _allowed_offset[frame.j] : 0;
+                const std::size_t last = sparse ? _allowed_offset[frame.j + 1] : _dp.v_feasible[n - 1].size();
+                for (std::size_t e = first; e < last; ++e) {
+                    const std::size_t k = sparse ? _allowed_source[e] : e;
+                    if (!_reached[_offset[n - 1] + k])
+                        continue;
+                    const bool taken = !label.paths.empty() && k == label.paths[0].from;
+                    label.pending.emplace_back(k, taken ? 1 : 0);
                 }
             }
         }
+
+        // a pending predecessor is extended once its path of that rank is found. it is dropped if it has none, or if
+        // the extension is infeasible, so that a dwell time constraint does not walk through all its paths.
+        bool waiting = false;
+        while (!label.pending.empty()) {
+            const auto [k, q] = label.pending.back();
+            RankedLabel &pred = _ranked_label(frame.i - 1, k);
+            if (pred.paths.size() <= q && !pred.exhausted) {
+                stack.push_back({frame.i - 1, k, q});
+                waiting = true;
+                break;
+            }
+            label.pending.pop_back();
+            if (pred.paths.size() <= q)
+                continue;
+            Ranked candidate;
+            if (_extend(frame.i, frame.j, k, q, candidate)) {
+                label.candidates.push_back(std::move(candidate));
+                std::push_heap(label.candidates.begin(), label.candidates.end(), later);
+            }
+        }
+        if (waiting)
+            continue;
+
+        // the best candidate is the next path, and the next path of its predecessor is the next candidate from it.
+        if (label.candidates.empty()) {
+            label.exhausted = true;
+            continue;
+        }
+        std::pop_heap(label.candidates.begin(), label.candidates.end(), later);
+        label.paths.push_back(std::move(label.candidates.back()));
+        label.candidates.pop_back();
+        label.pending.emplace_back(label.paths.back().from, label.paths.back().rank + 1);
+    }
+    return _ranked_label(i, j).paths.size() > r;
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_extend(int i, std::size_t j, std::size_t k, std::size_t rank, Ranked &out) {
+    const Ranked &from = _ranked_label(i - 1, k).paths[rank];
+    out.from = k;
+    out.rank = rank;
+
+    // the end of the paths adds nothing to them.
+    if (i == _dp.N) {
+        out.objective = from.objective;
+        out.cost = from.cost;
+        return true;
+    }
+
+    // the same candidate as relax, from the timers and state of the path instead of the ones of the label.
+    const ProblemConfig::disc_vector &vi = _dp.v_feasible[i - 1][k], &vni = _dp.v_feasible[i][j];
+    out.timers.resize(_slots);
+    if (_dwell_check(i, from.timers.data(), vi, vni, out.timers.data()))
+        return false;
+    const double zero = 0.0;
+    _v_rel.column(i, _col_nxt);
+    _stage_cost_at(i, j, _col_nxt, _stage);
+    if (_dp.include_state) {
+        _v_rel.column(i - 1, _col);
+        _state_cost(from.state.data(), _col, i - 1, _candidate);
+        add(_stage.data(), _stage.size(), _candidate.data(), _candidate.size(), _cost_nxt);
+    } else {
+        add(_stage.data(), _stage.size(), &zero, 1, _cost_nxt);
+    }
+    if (_dp.customize) {
+        _V = from.cost;
+        _custom_cost(i - 1, out.cost);
+    } else {
+        add(from.cost.data(), from.cost.size(), _cost_nxt.data(), _cost_nxt.size(), out.cost);
+    }
+    out.objective = _dp.objective(out.cost);
+    if (!(out.objective < INFTY[0]))
+        return false;
+    if (_dp.include_state) {
+        out.state.resize(_dp.x0.size());
+        _state_transition(from.state.data(), vni, i, j, out.state.data());
+    }
+    return true;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_solve_coarse() {
+    if (_dp.engine != ProblemConfig::Engine::Labels || _dp.include_state || _dp.customize)
+        throw std::runtime_error("Error: coarsening requires Engine::Labels, without include_state and customize.");
+
+    // a node is merged into the current stage while its relaxed column stays within the tolerance of the first node
+    // of the stage, and its feasible set is the same.
+    const int N = _dp.N;
+    std::vector<int> start{0};
+    for (int i = 1; i < N; ++i) {
+        bool merge = (_dp.v_feasible[i] == _dp.v_feasible[start.back()]);
+        for (std::size_t r = 0; merge && r < _v_rel.rows(); ++r)
+            merge = std::abs(_v_rel.at(r, i) - _v_rel.at(r, start.back())) <= _dp.coarsen_tolerance;
+        if (!merge)
+            start.push_back(i);
+    }
+    const int K = static_cast<int>(start.size());
+    start.push_back(N);
+    DPapprox::Log.log(DEBUG) << "Coarsened " << N << " nodes into " << K << " stages." << std::endl;
+
+    // the reduced problem has one node per stage, whose stage cost adds the stage costs of the merged nodes.
+    auto coarse = std::make_shared<ProblemConfig>(_dp);
+    coarse->N = K;
+    coarse->coarsen_tolerance = -1;
+    coarse->k_best = 1;
+    coarse->v_feasible.resize(K);
+    for (int k = 0; k < K; ++k)
+        coarse->v_feasible[k] = _dp.v_feasible[start[k]];
+    coarse->strategy = ProblemConfig::Strategy::Custom;
+    coarse->stage_cost_into = {};
+    coarse->stage_cost = [stage = _dp.stage_cost, view = _v_rel, start, dt = _dp.dt](
+            const ProblemConfig::disc_vector &v, const std::vector<double> &, int k, double) {
+        std::vector<double> col, c;
+        for (int i = start[k]; i < start[k + 1]; ++i) {
+            view.column(i, col);
+            c = (i == start[k]) ? stage(v, col, i, dt) : c + stage(v, col, i, dt);
+        }
+        return c;
+    };
+
+    std::vector<std::vector<double>> v_rel(_v_rel.rows(), std::vector<double>(K));
+    for (std::size_t r = 0; r < _v_rel.rows(); ++r)
+        for (int k = 0; k < K; ++k)
+            v_rel[r][k] = _v_rel.at(r, start[k]);
+
+    _coarse = std::make_unique<BasicSolver>(RelaxedView(), coarse);
+    _coarse->reset(v_rel);
+    _coarse->_hold.resize(K);
+    for (int k = 0; k < K; ++k)
+        _coarse->_hold[k] = start[k + 1] - start[k];
+    _coarse->solve();
+
+    // the reduced path is expanded back to the nodes of every stage.
+    const Solution &reduced = _coarse->solution;
+    solution = reduced;
+    solution.optimum_path.clear();
+    solution.optimum_path.reserve(N);
+    for (std::size_t k = 0; k < reduced.optimum_path.size(); ++k)
+        solution.optimum_path.insert(solution.optimum_path.end(), start[k + 1] - start[k], reduced.optimum_path[k]);
+    solution.last_node = (reduced.last_node < 0) ? -1 : start[reduced.last_node + 1] - 1;
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_separable() const {
+    return !_parts.empty() || _decomposes(_dp, _v_rel.rows());
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_decomposes(const ProblemConfig &dp, std::size_t rows) {
+    if (!dp.separable || dp.include_state || dp.customize || dp.scenarios > 0 || dp.allowed_transition ||
+        !dp.transitions.empty() || dp.k_best > 1)
+        return false;
+    const std::size_t nv = dp.v_feasible[0][0].size();
+    if (nv < 2 || rows != nv)
+        return false;
+
+    // a set of distinct vectors is the product of the values of its dimensions when it has as many elements.
+    for (const auto &values: dp.v_feasible) {
+        std::size_t product = 1;
+        for (std::size_t d = 0; d < nv; ++d) {
+            std::set<double> levels;
+            for (const ProblemConfig::disc_vector &v: values)
+                levels.insert(v[d]);
+            product *= levels.size();
+        }
+        if (product != values.size() || std::set<ProblemConfig::disc_vector>(values.begin(), values.end()).size() !=
+                                        values.size())
+            return false;
+    }
+    return true;
+}
+
+template<class Scalar>
+std::shared_ptr<ProblemConfig> BasicSolver<Scalar>::_part(const ProblemConfig &dp, std::size_t d) {
+    // the subproblem of dimension d keeps the values of d in their order of appearance, and the dwell times of d.
+    auto part = std::make_shared<ProblemConfig>(dp);
+    part->separable = false;
+    part->progress_callback = {};
+    part->phase_callback = {};
+    for (int i = 0; i < dp.N; ++i) {
+        std::vector<ProblemConfig::disc_vector> values;
+        for (const ProblemConfig::disc_vector &v: dp.v_feasible[i])
+            if (std::find(values.begin(), values.end(), ProblemConfig::disc_vector{v[d]}) == values.end())
+                values.push_back({v[d]});
+        part->v_feasible[i] = std::move(values);
+    }
+    for (auto &con: part->dwell_time_cons)
+        con.second = {con.second.at(d)};
+    for (auto &init: part->dwell_time_init)
+        init = {init.at(d)};
+    return part;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_solve_separable() {
+    const int N = _dp.N;
+    const std::size_t nv = _dp.v_feasible[0][0].size();
+
+    if (_parts.empty()) {
+        DPapprox::Log.log(DEBUG) << "Decomposing into " << nv << " dimensions." << std::endl;
+        for (std::size_t d = 0; d < nv; ++d)
+            _parts.push_back(std::make_unique<BasicSolver>(RelaxedView(), _part(_dp, d)));
+    }
+
+    // every dimension but the first runs on its own thread.
+    std::vector<std::vector<double>> row(1, std::vector<double>(N));
+    for (std::size_t d = 0; d < nv; ++d) {
+        for (int i = 0; i < N; ++i)
+            row[0][i] = _v_rel.at(d, i);
+        _parts[d]->reset(row);
+    }
+    std::vector<std::future<void>> jobs;
+    for (std::size_t d = 1; d < nv; ++d)
+        jobs.push_back(std::async(std::launch::async, [part = _parts[d].get()] { part->solve(); }));
+    _parts[0]->solve();
+    for (auto &job: jobs)
+        job.get();
+
+    // the paths are recombined per node, and the cost is summed over the full vectors.
+    solution = Solution{{}, {}, {}, 0, true, Solution::Status::Solved, N - 1};
+    solution.optimum_path.assign(N, ProblemConfig::disc_vector(nv));
+    for (std::size_t d = 0; d < nv; ++d) {
+        const Solution &part = _parts[d]->solution;
+        for (int i = 0; i < N; ++i)
+            solution.optimum_path[i][d] = part.optimum_path[i][0];
+        solution.success = solution.success && part.success;
+        if (solution.status == Solution::Status::Solved)
+            solution.status = part.status;
+        solution.last_node = (part.last_node < 0) ? -1 : std::min(solution.last_node, part.last_node);
+    }
+    for (int i = 0; i < N; ++i) {
+        _v_rel.column(i, _col);
+        _stage_cost(solution.optimum_path[i], _col, i, _stage);
+        solution.cost = (i == 0) ? _stage : solution.cost + _stage;
+    }
+    solution.objective = _dp.objective(solution.cost);
+    solution.success = solution.success && (solution.objective < INFTY.at(0));
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_solve_multires() {
+    const int N = _dp.N, F = _dp.multires_factor;
+    const int K = (N + F - 1) / F;
+
+    // the coarse problem averages the relaxed solution over blocks of F nodes, with a time step of F dt. dwell times
+    // are in time units, so they carry over. the callbacks see the first fine node of each block.
+    auto coarse = std::make_shared<ProblemConfig>(_dp);
+    coarse->N = K;
+    coarse->dt = F * _dp.dt;
+    coarse->multires_factor = 0;
+    coarse->k_best = 1;
+    coarse->v_feasible.resize(K);
+    for (int k = 0; k < K; ++k)
+        coarse->v_feasible[k] = _dp.v_feasible[k * F];
+    coarse->stage_cost_into = coarse->state_transition_into = coarse->state_cost_into = coarse->custom_cost_into = {};
+    coarse->stage_cost = [f = _dp.stage_cost, F](const ProblemConfig::disc_vector &v, const std::vector<double> &r,
+                                                 int k, double dt) { return f(v, r, k * F, dt); };
+    coarse->state_transition = [f = _dp.state_transition, F](const ProblemConfig::traj_vector &x,
+                                                             const ProblemConfig::disc_vector &v, int k, double dt) {
+        return f(x, v, k * F, dt);
+    };
+    coarse->state_cost = [f = _dp.state_cost, F](const ProblemConfig::traj_vector &x, const std::vector<double> &r,
+                                                 int k, double dt) { return f(x, r, k * F, dt); };
+    coarse->custom_cost = [f = _dp.custom_cost, F](std::vector<double> &V, std::vector<double> &cost_nxt, int k,
+                                                   double dt) { return f(V, cost_nxt, k * F, dt); };
+
+    std::vector<std::vector<double>> v_rel(_v_rel.rows(), std::vector<double>(K, 0.0));
+    for (std::size_t r = 0; r < _v_rel.rows(); ++r) {
+        for (int k = 0; k < K; ++k) {
+            const int last = std::min(N, (k + 1) * F);
+            for (int i = k * F; i < last; ++i)
+                v_rel[r][k] += _v_rel.at(r, i);
+            v_rel[r][k] /= (last - k * F);
+        }
     }
 
-    // get all keys at the end node
-    std::vector<std::pair<ProblemConfig::disc_vector, int>> keys;
-    keys.reserve(_dp.v_feasible[N - 1].size());
-    for (const ProblemConfig::disc_vector &val: _dp.v_feasible[N - 1])
-        keys.emplace_back(val, N - 1);
+    _coarse = std::make_unique<BasicSolver>(RelaxedView(), coarse);
+    _coarse->reset(v_rel);
+    _coarse->solve();
+    const auto &path = _coarse->solution.optimum_path;
 
-    std::vector<double> cost_end{INFTY};
-    ProblemConfig::disc_vector v_end{0};
-    // find the minimum cost to go
-    auto best = std::min_element(
-            keys.begin(), keys.end(),
-            [&](const auto& a, const auto& b) {
-                return _dp.objective(_cost_to_go[a]) < _dp.objective(_cost_to_go[b]);
+    // the fine problem allows at each node the values of the coarse path within [corridor] blocks. the nodes around
+    // a node where the fine solve hit INFTY get their full feasible set, over a window that doubles at every retry.
+    std::vector<char> open(N, 0);
+    int window = F;
+    while (true) {
+        auto fine = std::make_shared<ProblemConfig>(_dp);
+        fine->multires_factor = 0;
+        bool restricted = false;
+        for (int i = 0; i < N; ++i) {
+            if (open[i])
+                continue;
+            const int b = i / F;
+            const int first = std::max(0, b - _dp.corridor);
+            const int last = std::min(K - 1, b + _dp.corridor);
+            std::vector<ProblemConfig::disc_vector> allowed;
+            for (const ProblemConfig::disc_vector &v: _dp.v_feasible[i])
+                if (std::find(path.begin() + first, path.begin() + last + 1, v) != path.begin() + last + 1)
+                    allowed.push_back(v);
+            if (!allowed.empty() && allowed.size() < _dp.v_feasible[i].size()) {
+                fine->v_feasible[i] = std::move(allowed);
+                restricted = true;
             }
-    );
-    if (best != keys.end()) {
-        cost_end = _cost_to_go[*best];
-        v_end = best->first;
+        }
+
+        _fine = std::make_unique<BasicSolver>(_v_rel, fine);
+        _fine->solve();
+        if (_fine->solution.status != Solution::Status::Infeasible || !restricted)
+            break;
+
+        const int node = _fine->solution.last_node;
+        if (node < 0 || node == N - 1)
+            std::fill(open.begin(), open.end(), 1);
+        else
+            std::fill(open.begin() + std::max(0, node - window), open.begin() + std::min(N, node + window + 1), 1);
+        DPapprox::Log.log(DEBUG) << "Widening the corridor around node " << node << "." << std::endl;
+        window *= 2;
     }
+    solution = _fine->solution;
+    solutions = _fine->solutions;
+}
 
-    std::vector<ProblemConfig::disc_vector> optimum_path {v_end};
-    std::vector<ProblemConfig::traj_vector> optimum_traj {};
+template<class Scalar>
+void BasicSolver<Scalar>::_fallback() {
+    auto &path = solution.optimum_path;
+    const int N = _dp.N;
 
-    optimum_path.reserve(N + 1);
-    optimum_traj.reserve(N + 1);
-    // backward recursion to calculate optimum path and traj
-    for (auto i = N - 1; i > 0; --i) {
-        optimum_path.emplace(optimum_path.begin(), _path_to_go[{optimum_path[0], i}]);
+    // the traj is replayed along the path, and the greedy part adds the stage and state costs of the DP.
+    auto &traj = solution.optimum_traj;
+    traj.clear();
+    if (_dp.include_state) {
+        traj.push_back(_dp.x0);
+        for (std::size_t i = 0; i < path.size(); ++i)
+            traj.push_back(_dp.state_transition(traj.back(), path[i], static_cast<int>(i), _dp.dt));
+    }
+
+    for (int i = static_cast<int>(path.size()); i < N; ++i) {
+        _v_rel.column(i, _col);
+        std::size_t j_opt = 0;
+        double opt = 0;
+        std::vector<double> c_opt;
+        for (std::size_t j = 0; j < _dp.v_feasible[i].size(); ++j) {
+            std::vector<double> c = _dp.stage_cost(_dp.v_feasible[i][j], _col, i, _dp.dt);
+            double objective = _dp.objective(c);
+            if (j == 0 || objective < opt) {
+                j_opt = j;
+                opt = objective;
+                c_opt = std::move(c);
+            }
+        }
+        path.push_back(_dp.v_feasible[i][j_opt]);
+
+        std::vector<double> cost_nxt = c_opt;
+        if (_dp.include_state && i > 0) {
+            _v_rel.column(i - 1, _col_nxt);
+            cost_nxt = cost_nxt + _dp.state_cost(traj[i], _col_nxt, i - 1, _dp.dt);
+        }
+        if (i == 0)
+            solution.cost = cost_nxt;
+        else if (!_dp.customize)
+            solution.cost = solution.cost + cost_nxt;
+        else
+            solution.cost = _dp.custom_cost(solution.cost, cost_nxt, i - 1, _dp.dt);
         if (_dp.include_state)
-            optimum_traj.emplace(optimum_traj.begin(), _next_state[{optimum_path[0], i}]);
+            traj.push_back(_dp.state_transition(traj.back(), path.back(), i, _dp.dt));
     }
 
-    // save in solution
-    solution.optimum_path = optimum_path;
-    solution.objective = _dp.objective(cost_end);
-    solution.success = (solution.objective < INFTY.at(0));
-    solution.cost = cost_end;
-    if (solution.success)
-        DPapprox::Log.log(INFO) << "Solved." << std::endl;
-    else
-        DPapprox::Log.log(INFO) << "Something went wrong!" << std::endl;
+    solution.objective = _dp.objective(solution.cost);
+    solution.success = false;
+}
 
+template<class Scalar>
+Plan BasicSolver<Scalar>::_estimate(const ProblemConfig &dp, std::size_t dim) {
+    // the label tables: costs, flag, timers and states per label, and offsets, sizes and packed widths per node.
+    // predecessors take the bits of the size of the previous node, unless they are spilled to a file.
+    std::size_t labels = 0, width = 0, bits = 0;
+    for (std::size_t i = 0; i < dp.v_feasible.size(); ++i) {
+        const std::size_t n = dp.v_feasible[i].size();
+        labels += n;
+        width = std::max(width, n);
+        if (i > 0)
+            bits += n * std::bit_width(dp.v_feasible[i - 1].size() - 1);
+    }
+    const std::size_t nv = labels ? dp.v_feasible[0][0].size() : 0;
+    const std::size_t slots = dp.dwell_time_cons.size() * nv;
+    const std::size_t nx = dp.include_state ? dp.x0.size() : 0;
 
-    if (_dp.include_state){
-        v_ini = {optimum_path.at(0), 0};
-        optimum_traj.emplace(optimum_traj.begin(), _next_state[v_ini]);
-        optimum_traj.emplace(optimum_traj.begin(), _dp.x0);
-        solution.optimum_traj = optimum_traj;
+    Plan plan;
+    plan.labels = labels;
+    plan.table_bytes = labels * (sizeof(Scalar) * dim + sizeof(double) * (slots + nx) + sizeof(char))
+                       + (dp.N + 1) * (3 * sizeof(std::size_t) + sizeof(std::uint64_t) + sizeof(std::uint8_t));
+    plan.path_bytes = (bits / 64 + 2) * sizeof(std::uint64_t);
+    plan.path_spilled = dp.path_budget != 0 && plan.path_bytes > dp.path_budget;
+    plan.workspace_bytes = (width * width + 3 * width) * sizeof(Scalar) + (width + 2 * slots) * sizeof(double)
+                           + width * nv * sizeof(char);
+    plan.peak_bytes = plan.table_bytes + (plan.path_spilled ? 0 : plan.path_bytes) + plan.workspace_bytes;
+    return plan;
+}
+
+template<class Scalar>
+std::pmr::monotonic_buffer_resource *BasicSolver<Scalar>::_make_arena() {
+    // the arena holds the label tables, with one cost element per input assumed unless a strategy sets their size.
+    const std::size_t nv = _dp.v_feasible.empty() || _dp.v_feasible[0].empty() ? 0 : _dp.v_feasible[0][0].size();
+    const std::size_t dim = (_dp.strategy != ProblemConfig::Strategy::Custom) ? strategies::cost_dim(_dp.strategy, nv)
+                                                                               : nv;
+    const std::size_t size = _estimate(_dp, dim).peak_bytes + 4096;
+
+    // the tables initialize what they use, so the buffer is left uninitialized rather than zeroed.
+    _arena_buffer = std::make_unique_for_overwrite<std::byte[]>(size);
+    _arena = std::make_unique<std::pmr::monotonic_buffer_resource>(_arena_buffer.get(), size,
+                                                                   std::pmr::new_delete_resource());
+    return _arena.get();
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_reset_tables() {
+    // the tables are refilled in place, so they keep their capacity from the last solve.
+    const int N = _dp.N;
+    const std::size_t nv = _dp.v_feasible[0][0].size();
+    _slots = _dp.dwell_time_cons.size() * nv;
+
+    _offset.resize(N + 1, 0);
+    for (int i = 0; i < N; ++i)
+        _offset[i + 1] = _offset[i] + _dp.v_feasible[i].size();
+    const std::size_t labels = _offset[N];
+
+    _dim.assign(N, 0);
+    _cost_offset.assign(N, 0);
+    _cost_to_go.clear();
+    _cost_to_go.reserve(labels * nv);
+    _path_to_go.reset(_offset, _dp.path_budget);
+    _reached.assign(labels, 0);
+    _timers.assign(labels * _slots, 0.0);
+    if (_dp.include_state)
+        _next_state.assign(labels * _dp.x0.size(), 0.0);
+    // the caches outlive the tables, a transition does not depend on the relaxed solution.
+    if (_dp.include_state && _dp.memo_capacity > 0 && !_transition_memo.enabled()) {
+        _transition_memo.reset(_dp.memo_capacity, _dp.x0.size(), _dp.memo_quantum);
+        _state_cost_memo.reset(_dp.memo_capacity, _dp.x0.size(), _dp.memo_quantum);
     }
+    _dwell.resize(_slots);
+    _dwell_opt.resize(_slots);
 }
 
-void Solver::_set_timers() {
-    if (_dp.dwell_time_init.empty()) {
-        _dp.dwell_time_init.resize(_dp.dwell_time_cons.size(),
-                                  std::vector<double>(_dp.v_feasible[0][0].size(), 0.0));
+template<class Scalar>
+void BasicSolver<Scalar>::_truncate_tables(int first) {
+    // the costs are appended node by node, so the costs of node [first] onward are the tail of [cost_to_go].
+    const int N = _dp.N;
+    if (first >= N)
+        return;
+    const std::size_t label = _offset[first];
+    if (_dim[first] != 0)
+        _cost_to_go.resize(_cost_offset[first]);
+    std::fill(_dim.begin() + first, _dim.end(), 0);
+    std::fill(_cost_offset.begin() + first, _cost_offset.end(), 0);
+    std::fill(_reached.begin() + label, _reached.end(), 0);
+    std::fill(_timers.begin() + label * _slots, _timers.end(), 0.0);
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_store_cost(int i, std::size_t j, const std::vector<double> &cost) {
+    // the cost size of a node is set by its first label.
+    if (_dim[i] == 0) {
+        _dim[i] = cost.size();
+        _cost_offset[i] = _cost_to_go.size();
+        _cost_to_go.resize(_cost_to_go.size() + (_offset[i + 1] - _offset[i]) * cost.size(), 0.0);
     }
+    if (cost.size() != _dim[i])
+        throw std::runtime_error("Error: costs of one node must have the same size.");
+    std::copy(cost.begin(), cost.end(), _cost_to_go.begin() + _cost_offset[i] + j * _dim[i]);
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_relax(int i) {
+    const auto &preds = _dp.v_feasible[i];
+    const auto &succs = _dp.v_feasible[i + 1];
+    const std::size_t base = _offset[i];
+    const std::size_t dim = _dim[i];
+    const double opt_0 = _dp.objective({std::numeric_limits<double>::infinity()});
+    const double zero = 0.0;
+    const bool sparse = _allowed(i);
+    bool alive = false;
+    _frontier = INFTY[0];
 
-    std::unordered_map<std::pair<ProblemConfig::disc_vector, int>, std::vector<double>, ProblemConfig::pair_hash> timer;
-    _timers.reserve(_dp.dwell_time_init.size());
-    for (const std::vector<double> &timer_0: _dp.dwell_time_init) {
-        for (const ProblemConfig::disc_vector &v_0: _dp.v_feasible[0])
-            timer[{v_0, 0}] = timer_0;
-        _timers.push_back(timer);
+    _v_rel.column(i + 1, _col_nxt);
+    _state_costs(i);
+
+    for (std::size_t j = 0; j < succs.size(); ++j) {
+        const ProblemConfig::disc_vector &vni = succs[j];
+        std::vector<double> &c = _stage;
+        _stage_cost_at(i + 1, j, _col_nxt, c); // stage cost at i + 1.
+
+        double opt = opt_0; // initialize optimal value at infinity.
+        std::int64_t k_opt = -1;
+        const std::size_t first = sparse ? _allowed_offset[j] : 0;
+        const std::size_t last = sparse ? _allowed_offset[j + 1] : preds.size();
+        for (std::size_t e = first; e < last; ++e) {
+            const std::size_t k = sparse ? _allowed_source[e] : e;
+            if (!_reached[base + k])
+                continue;
+
+            // check for dwell time violations. if DWELL_FLAG is found, set d cost to infinity.
+            const double d = _dwell_check(i + 1, _timers.data() + (base + k) * _slots, preds[k], vni, _dwell.data())
+                             ? INFTY[0] : 0.0;
+
+            // cost_nxt = c + d + p, p is zero without states.
+            add(c.data(), c.size(), &d, 1, _step);
+            if (_dp.include_state)
+                add(_step.data(), _step.size(), _p[k].data(), _p[k].size(), _cost_nxt);
+            else
+                add(_step.data(), _step.size(), &zero, 1, _cost_nxt);
+
+            // the total cost is V + cost of the next stage. user can customize the total cost by custom_cost.
+            // a single precision V is widened for the callbacks.
+            const Scalar *V = _cost_to_go.data() + _cost_offset[i] + k * dim;
+            if (_dp.customize) {
+                _V.assign(V, V + dim);
+                _custom_cost(i, _candidate);
+            } else if constexpr (std::is_same_v<Scalar, double>) {
+                add(V, dim, _cost_nxt.data(), _cost_nxt.size(), _candidate);
+            } else {
+                _V.assign(V, V + dim);
+                add(_V.data(), dim, _cost_nxt.data(), _cost_nxt.size(), _candidate);
+            }
+
+            // the minimum objective is selected, and the values are kept for cost to go, path to go, and timers.
+            const double objective = _dp.objective(_candidate);
+            if (objective < opt) {
+                opt = objective;
+                k_opt = static_cast<std::int64_t>(k);
+                _opt.swap(_candidate);
+                _dwell_opt.swap(_dwell);
+            }
+        }
+        if (k_opt < 0)
+            continue;
+        alive = alive || (opt < INFTY[0]);
+        _frontier = std::min(_frontier, opt);
+        _store_best(i, j, static_cast<std::size_t>(k_opt));
     }
+    return alive;
 }
 
-std::vector<double> Solver::_dwell_time(const std::pair<std::vector<int>, std::vector<double>> &con,
-                                       std::vector<double> yi, const ProblemConfig::disc_vector& vi,
-                                       const ProblemConfig::disc_vector& vni, int i) const {
+template<class Scalar>
+template<class Strategy>
+bool BasicSolver<Scalar>::_relax_native(int i) {
+    const auto &preds = _dp.v_feasible[i];
+    const auto &succs = _dp.v_feasible[i + 1];
+    const std::size_t base = _offset[i], nv = preds[0].size();
+    const std::size_t dim = _dim[i], n = Strategy::dim(nv), width = Strategy::stage_dim(nv);
+    const double zero = 0.0;
+    const bool sparse = _allowed(i);
+    bool alive = false;
+    _frontier = INFTY[0];
 
-    std::transform(yi.begin(), yi.end(), yi.begin(),
-                   [&](double y) { return y - _dp.dt; });
+    _v_rel.column(i + 1, _col_nxt);
+    _state_costs(i);
+    if (dim != n)
+        throw std::runtime_error("Error: costs of one node must have the same size.");
 
-    std::vector<double> yni = yi;
-    for (size_t idx = 0; idx < yi.size(); ++idx) {
-        if (yi[idx] <= 0)
-            yni[idx] = 0;
+    // same as _relax, with the kernels of the strategy in place of stage_cost, custom_cost and objective.
+    for (std::size_t j = 0; j < succs.size(); ++j) {
+        const ProblemConfig::disc_vector &vni = succs[j];
+        _stage_cost_at(i + 1, j, _col_nxt, _stage);
+
+        double opt = std::numeric_limits<double>::infinity();
+        std::int64_t k_opt = -1;
+        const std::size_t first = sparse ? _allowed_offset[j] : 0;
+        const std::size_t last = sparse ? _allowed_offset[j + 1] : preds.size();
+        for (std::size_t e = first; e < last; ++e) {
+            const std::size_t k = sparse ? _allowed_source[e] : e;
+            if (!_reached[base + k])
+                continue;
+            const double d = _dwell_check(i + 1, _timers.data() + (base + k) * _slots, preds[k], vni, _dwell.data())
+                             ? INFTY[0] : 0.0;
+            const double *p = _dp.include_state ? _p[k].data() : &zero;
+            const std::size_t np = _dp.include_state ? _p[k].size() : 1;
+            if (np != 1 && np != width)
+                throw std::runtime_error("Error: state_cost must return one element or one per stage cost "
+                                         "element with a built-in strategy.");
+
+            _candidate.resize(n);
+            Strategy::combine(_cost_to_go.data() + _cost_offset[i] + k * dim, _stage.data(), d, p, np, nv,
+                              _candidate.data());
+            const double objective = Strategy::objective(_candidate.data(), nv);
+            if (objective < opt) {
+                opt = objective;
+                k_opt = static_cast<std::int64_t>(k);
+                _opt.swap(_candidate);
+                _dwell_opt.swap(_dwell);
+            }
+        }
+        if (k_opt < 0)
+            continue;
+        alive = alive || (opt < INFTY[0]);
+        _frontier = std::min(_frontier, opt);
+        _store_best(i, j, static_cast<std::size_t>(k_opt));
+    }
+    return alive;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_state_costs(int i) {
+    // if states are included, calculate state cost p of every label at i.
+    if (!_dp.include_state)
+        return;
+    const std::size_t base = _offset[i], labels = _offset[i + 1] - base, nx = _dp.x0.size();
+    _v_rel.column(i, _col);
+    _p.resize(labels);
+    for (std::size_t l = 0; l < labels; ++l) {
+        if (!_reached[base + l]) continue;
+        _state_cost(_next_state.data() + (base + l) * nx, _col, i, _p[l]);
+    }
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_store_best(int i, std::size_t j, std::size_t k) {
+    const std::size_t label = _offset[i + 1] + j, nx = _dp.x0.size();
+    _store_cost(i + 1, j, _opt);
+    _path_to_go.set(i + 1, j, static_cast<std::uint32_t>(k));
+    _reached[label] = 1;
+    std::copy(_dwell_opt.begin(), _dwell_opt.end(), _timers.begin() + label * _slots);
+    if (_dp.include_state)
+        _state_transition(_next_state.data() + (_offset[i] + k) * nx, _dp.v_feasible[i + 1][j], i + 1, j,
+                          _next_state.data() + label * nx);
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_relax_min_plus(int i, kernels::MinPlusOp op) {
+    const auto &preds = _dp.v_feasible[i];
+    const auto &succs = _dp.v_feasible[i + 1];
+    const std::size_t n = preds.size(), m = succs.size();
+    const std::size_t base = _offset[i], base_nxt = _offset[i + 1];
+
+    // V is contiguous for scalar costs, c and the dwell penalties are laid out for the kernel.
+    _v_rel.column(i + 1, _col_nxt);
+    _c.resize(m);
+    for (std::size_t j = 0; j < m; ++j) {
+        _stage_cost_at(i + 1, j, _col_nxt, _stage);
+        if (_stage.size() != 1)
+            throw std::runtime_error("Error: min-plus kernel requires stage_cost to return a single element.");
+        _c[j] = _stage[0];
+    }
+
+    _best.resize(m);
+    _arg.resize(m);
+    const Scalar infty = Limits<Scalar>::infty;
+    const Scalar *V = _cost_to_go.data() + _cost_offset[i];
+    // a dwell violation depends on the successor only through the inputs it changes, so the inputs every reached
+    // predecessor may not leave are found once, rather than once per pair.
+    const std::size_t nv = succs.empty() ? 0 : succs[0].size();
+    _locked.resize(n * nv);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (_reached[base + k])
+            _dwell_lock(base + k, preds[k], &_locked[k * nv]);
+    }
+    if (_allowed(i)) {
+        // only the allowed predecessors are visited, with the selection rule of the kernel.
+        for (std::size_t j = 0; j < m; ++j) {
+            Scalar best = std::numeric_limits<Scalar>::infinity();
+            _best[j] = best;
+            _arg[j] = n;
+            for (std::uint32_t e = _allowed_offset[j]; e < _allowed_offset[j + 1]; ++e) {
+                const std::size_t k = _allowed_source[e];
+                if (!_reached[base + k])
+                    continue;
+                const Scalar pen = _dwell_blocked(&_locked[k * nv], preds[k], succs[j]) ? infty : 0;
+                const Scalar cost = V[k] + (_c[j] + pen);
+                const Scalar objective = (op == kernels::MinPlusOp::Absolute) ? std::abs(cost) : cost;
+                if (objective < best) {
+                    best = objective;
+                    _best[j] = cost;
+                    _arg[j] = k;
+                }
+            }
+        }
+    } else {
+        _pen.resize(n * m);
+        for (std::size_t j = 0; j < m; ++j) {
+            for (std::size_t k = 0; k < n; ++k) {
+                if (!_reached[base + k])
+                    _pen[j * n + k] = std::numeric_limits<Scalar>::infinity();
+                else
+                    _pen[j * n + k] = _dwell_blocked(&_locked[k * nv], preds[k], succs[j]) ? infty : 0;
+            }
+        }
+        kernels::min_plus(V, n, _c.data(), _pen.data(), m, op, _best.data(), _arg.data());
+    }
+
+    // write the winners, recomputing their timers.
+    bool alive = false;
+    _frontier = INFTY[0];
+    _dim[i + 1] = 1;
+    _cost_offset[i + 1] = _cost_to_go.size();
+    _cost_to_go.resize(_cost_to_go.size() + m, 0.0);
+    for (std::size_t j = 0; j < m; ++j) {
+        if (_arg[j] == n)
+            continue;
+        const std::size_t label = base_nxt + j;
+        _cost_to_go[_cost_offset[i + 1] + j] = _best[j];
+        _path_to_go.set(i + 1, j, static_cast<std::uint32_t>(_arg[j]));
+        _reached[label] = 1;
+        _dwell_check(i + 1, _timers.data() + (base + _arg[j]) * _slots, preds[_arg[j]], succs[j],
+                     _timers.data() + label * _slots);
+        const Scalar objective = (op == kernels::MinPlusOp::Absolute) ? std::abs(_best[j]) : _best[j];
+        alive = alive || (objective < infty);
+        _frontier = std::min(_frontier, static_cast<double>(objective));
+    }
+    return alive;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_stage_cost_at(int i, std::size_t j, const std::vector<double> &r,
+                                         std::vector<double> &out) const {
+    if (_stages) {
+        const std::size_t value = _stages->offset[i] + j;
+        out.assign(_stages->cost.begin() + _stages->first[value], _stages->cost.begin() + _stages->first[value + 1]);
+    } else {
+        _stage_cost(_dp.v_feasible[i][j], r, i, out);
+    }
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_stage_cost(const ProblemConfig::disc_vector &v, const std::vector<double> &r, int i,
+                                      std::vector<double> &out) const {
+    using Strategy = ProblemConfig::Strategy;
+    const std::size_t nv = v.size();
+    switch (_dp.strategy) {
+        case Strategy::SimpleRounding:
+            out.resize(strategies::SimpleRounding::stage_dim(nv));
+            return strategies::SimpleRounding::stage(v.data(), r.data(), nv, _dp.dt, out.data());
+        case Strategy::SumUp:
+            out.resize(strategies::SumUp::stage_dim(nv));
+            return strategies::SumUp::stage(v.data(), r.data(), nv, _dp.dt, out.data());
+        case Strategy::SumUpInfNorm:
+            out.resize(strategies::SumUpInfNorm::stage_dim(nv));
+            return strategies::SumUpInfNorm::stage(v.data(), r.data(), nv, _dp.dt, out.data());
+        case Strategy::CIA:
+            out.resize(strategies::CIA::stage_dim(nv));
+            return strategies::CIA::stage(v.data(), r.data(), nv, _dp.dt, out.data());
+        default:
+            break;
+    }
+    if (_dp.stage_cost_into) {
+        out.resize(_dp.cost_dim);
+        _dp.stage_cost_into(v, r, i, _dp.dt, out);
+    } else {
+        out = _dp.stage_cost(v, r, i, _dp.dt);
+    }
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_state_cost(const double *x, const std::vector<double> &r, int i, std::vector<double> &out) {
+    const std::size_t nx = _dp.x0.size();
+    const bool memo = _state_cost_memo.enabled();
+    if (memo) {
+        if (const double *hit = _state_cost_memo.find(i, 0, x)) {
+            out.assign(hit, hit + _state_cost_memo.width());
+            return;
+        }
+    }
+    if (_dp.state_cost_into) {
+        out.resize(_dp.state_cost_dim);
+        _dp.state_cost_into({x, nx}, r, i, _dp.dt, out);
+    } else {
+        _x.assign(x, x + nx);
+        out = _dp.state_cost(_x, r, i, _dp.dt);
+    }
+    if (memo)
+        _state_cost_memo.insert(i, 0, x, out.data(), out.size());
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_state_transition(const double *x, const ProblemConfig::disc_vector &v, int i,
+                                            std::size_t j, double *out) {
+    const std::size_t nx = _dp.x0.size();
+    const bool memo = _transition_memo.enabled();
+    if (memo) {
+        if (const double *hit = _transition_memo.find(i, j, x)) {
+            std::copy(hit, hit + nx, out);
+            return;
+        }
+    }
+    if (_dp.state_transition_into) {
+        _dp.state_transition_into({x, nx}, v, i, _dp.dt, {out, nx});
+    } else {
+        _x.assign(x, x + nx);
+        ProblemConfig::traj_vector xni = _dp.state_transition(_x, v, i, _dp.dt);
+        std::copy(xni.begin(), xni.end(), out);
+    }
+    if (memo)
+        _transition_memo.insert(i, j, x, out, nx);
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_custom_cost(int i, std::vector<double> &out) {
+    if (_dp.custom_cost_into) {
+        out.resize(_dp.cost_dim);
+        _dp.custom_cost_into(_V, _cost_nxt, i, _dp.dt, out);
+    } else {
+        out = _dp.custom_cost(_V, _cost_nxt, i, _dp.dt);
+    }
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_allowed(int i) {
+    if (!_dp.allowed_transition)
+        return false;
+
+    // the relation is evaluated once per distinct pair of feasible sets, consecutive stages usually share it.
+    const auto &preds = _dp.v_feasible[i];
+    const auto &succs = _dp.v_feasible[i + 1];
+    if (_allowed_node >= 0 && preds == _dp.v_feasible[_allowed_node] && succs == _dp.v_feasible[_allowed_node + 1])
+        return true;
+
+    _allowed_offset.assign(succs.size() + 1, 0);
+    _allowed_source.clear();
+    for (std::size_t j = 0; j < succs.size(); ++j) {
+        for (std::size_t k = 0; k < preds.size(); ++k)
+            if (_dp.allowed_transition(preds[k], succs[j]))
+                _allowed_source.push_back(static_cast<std::uint32_t>(k));
+        _allowed_offset[j + 1] = static_cast<std::uint32_t>(_allowed_source.size());
+    }
+    _allowed_node = i;
+    return true;
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_min_plus_op(const ProblemConfig &dp, std::size_t dim, kernels::MinPlusOp &op) {
+    if (dp.customize || dp.include_state)
+        return false;
+
+    switch (dp.resolved_objective_kind()) {
+        case ProblemConfig::ObjectiveKind::Identity:
+            op = kernels::MinPlusOp::Identity;
+            break;
+        case ProblemConfig::ObjectiveKind::Absolute:
+            op = kernels::MinPlusOp::Absolute;
+            break;
+        default:
+            return false;
+    }
+
+    // the kernel works on scalar costs only.
+    return dim == 1;
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_dwell_check(int node, const double *timers, const ProblemConfig::disc_vector &vi,
+                                       const ProblemConfig::disc_vector &vni, double *dwell) const {
+    const std::size_t nv = vi.size();
+    for (std::size_t k = 0; k < _dp.dwell_time_cons.size(); ++k)
+        _dwell_time(_dp.dwell_time_cons[k], timers + k * nv, vi, vni, dwell + k * nv);
+
+    // a merged stage runs the timers down over its nodes after the first one.
+    if (!_hold.empty())
+        _run_down(dwell, _hold[node]);
+
+    // check if there is any DWELL_FLAG
+    return std::find(dwell, dwell + _slots, DWELL_FLAG) != dwell + _slots;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_dwell_lock(std::size_t from, const ProblemConfig::disc_vector &vi, char *locked) const {
+    // an input may not be left while the timer of the constraint its value ends is still running (see _dwell_time).
+    const std::size_t nv = vi.size();
+    std::fill_n(locked, nv, 0);
+    for (std::size_t k = 0; k < _dp.dwell_time_cons.size(); ++k) {
+        const auto &con = _dp.dwell_time_cons[k];
+        const double *yi = _timers.data() + from * _slots + k * nv;
+        for (std::size_t idx = 0; idx < nv; ++idx) {
+            if ((yi[idx] - _dp.dt > 0) && (vi[idx] == con.first.back()))
+                locked[idx] = 1;
+        }
+    }
+}
+
+template<class Scalar>
+bool BasicSolver<Scalar>::_dwell_blocked(const char *locked, const ProblemConfig::disc_vector &vi,
+                                         const ProblemConfig::disc_vector &vni) {
+    for (std::size_t idx = 0; idx < vi.size(); ++idx) {
+        if (locked[idx] && vni[idx] != vi[idx])
+            return true;
+    }
+    return false;
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_run_down(double *dwell, int hold) const {
+    for (std::size_t s = 0; s < _slots; ++s) {
+        if (dwell[s] == DWELL_FLAG)
+            continue;
+        for (int h = 1; h < hold; ++h) {
+            const double y = dwell[s] - _dp.dt;
+            dwell[s] = (y <= 0) ? 0 : y;
+        }
+    }
+}
+
+template<class Scalar>
+void BasicSolver<Scalar>::_dwell_time(const std::pair<std::vector<int>, std::vector<double>> &con,
+                                      const double *yi, const ProblemConfig::disc_vector& vi,
+                                      const ProblemConfig::disc_vector& vni, double *yni) const {
+
+    for (size_t idx = 0; idx < vi.size(); ++idx) {
+        const double y = yi[idx] - _dp.dt;
+        yni[idx] = (y <= 0) ? 0 : y;
 
         if (vni[idx] != vi[idx]) {
-            if ((yi[idx] > 0) && (vi[idx] == con.first.back()))
+            if ((y > 0) && (vi[idx] == con.first.back()))
                 yni[idx] = DWELL_FLAG;
             else {
                 auto it = std::find(con.first.begin(), con.first.end(), vni[idx]);
@@ -191,7 +1737,9 @@ std::vector<double> Solver::_dwell_time(const std::pair<std::vector<int>, std::v
             }
         }
     }
-    return yni;
 }
 
+template class BasicSolver<double>;
+template class BasicSolver<float>;
+
 }
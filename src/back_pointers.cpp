@@ -0,0 +1,71 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "back_pointers.h"
+#include "logger.h"
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace DPapprox {
+
+BackPointers::BackPointers(std::pmr::memory_resource *resource)
+    : _width(resource), _bit(resource), _words(resource) {}
+
+BackPointers::~BackPointers() {
+    _unmap();
+}
+
+void BackPointers::_allocate(std::size_t n_words, std::size_t budget) {
+    _n_words = n_words;
+    const std::size_t size = n_words * sizeof(std::uint64_t);
+    if (budget == 0 || size <= budget) {
+        // a table that fits keeps its memory over solves, a spilled one is mapped again for every solve.
+        _unmap();
+        _words.resize(n_words);
+        _data = _words.data();
+        return;
+    }
+
+    _unmap();
+    _words.clear();
+    _words.shrink_to_fit();
+    const char *dir = std::getenv("TMPDIR");
+    std::string path = std::string(dir ? dir : "/tmp") + "/dpapprox_XXXXXX";
+    int fd = ::mkstemp(path.data());
+    if (fd < 0)
+        throw std::runtime_error("Error: Cannot create a temporary file in " + path + ".");
+    // the file is unlinked right away, and goes away with the mapping.
+    ::unlink(path.c_str());
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Error: Cannot size the temporary file of the back pointers.");
+    }
+    _map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_map == MAP_FAILED) {
+        _map = nullptr;
+        throw std::runtime_error("Error: Cannot map the temporary file of the back pointers.");
+    }
+    _map_size = size;
+    _data = static_cast<std::uint64_t *>(_map);
+    DPapprox::Log.log(DEBUG) << "Back pointers spilled to a " << size << " byte file." << std::endl;
+}
+
+void BackPointers::_unmap() {
+    if (_map)
+        ::munmap(_map, _map_size);
+    _map = nullptr;
+    _map_size = 0;
+}
+
+}
@@ -0,0 +1,281 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "dpapprox_c.h"
+#include "DPapprox.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+
+using namespace DPapprox;
+
+struct dpapprox_solver {
+    std::unique_ptr<Solver> solver;
+    std::size_t n_inputs{0};
+    int N{0};
+    bool solved{false};
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+// thrown when a user callback reports a failure, so that it can be told apart from solver errors.
+struct callback_error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+dpapprox_status fail(dpapprox_status status, const std::string &message) {
+    last_error = message;
+    return status;
+}
+
+template<class F>
+dpapprox_status guard(F &&f) {
+    try {
+        return f();
+    } catch (const callback_error &e) {
+        return fail(DPAPPROX_ERROR_CALLBACK, e.what());
+    } catch (const std::exception &e) {
+        return fail(DPAPPROX_ERROR_SOLVER, e.what());
+    } catch (...) {
+        return fail(DPAPPROX_ERROR_SOLVER, "Error: unknown exception.");
+    }
+}
+
+void check(int code, const char *callback) {
+    if (code != 0)
+        throw callback_error(std::string("Error: ") + callback + " callback returned " + std::to_string(code) + ".");
+}
+
+// the fields of [s] that fit in its struct_size, the ones appended after them zeroed to take their defaults, so that
+// callers built against an older header keep working.
+template<class T>
+T fitted(const T &s) {
+    T out{};
+    std::memcpy(&out, &s, std::min(s.struct_size, sizeof(T)));
+    out.struct_size = sizeof(T);
+    return out;
+}
+
+// writes back the fields of [s] that fit in the struct_size of the caller's [out].
+template<class T>
+void write_fitted(const T &s, T &out) {
+    const std::size_t size = out.struct_size;
+    std::memcpy(&out, &s, std::min(size, sizeof(T)));
+    out.struct_size = size;
+}
+
+// checks that the feasible values of every node lie within [values], and that there is at least one.
+bool valid_feasible(const dpapprox_feasible &f, int N) {
+    if (!f.node_offsets)
+        return f.n_values > 0;
+    for (int i = 0; i < N; ++i)
+        if (f.node_offsets[i] >= f.node_offsets[i + 1])
+            return false;
+    return f.node_offsets[N] <= f.n_values;
+}
+
+// translates the C problem definition into a ProblemConfig, wrapping the callbacks.
+ProblemConfig make_config(const dpapprox_problem &p) {
+    ProblemConfig config;
+    config.N = p.N;
+    config.dt = p.dt;
+
+    const dpapprox_feasible &f = p.feasible;
+    auto value = [&](std::size_t k) {
+        return ProblemConfig::disc_vector(f.values + k * f.n_inputs, f.values + (k + 1) * f.n_inputs);
+    };
+    config.v_feasible.resize(p.N);
+    for (int i = 0; i < p.N; ++i) {
+        std::size_t first = f.node_offsets ? f.node_offsets[i] : 0;
+        std::size_t last = f.node_offsets ? f.node_offsets[i + 1] : f.n_values;
+        if (i > 0 && !f.node_offsets) {
+            config.v_feasible[i] = config.v_feasible[0];
+            continue;
+        }
+        for (std::size_t k = first; k < last; ++k)
+            config.v_feasible[i].push_back(value(k));
+    }
+
+    for (std::size_t k = 0; k < p.n_dwell; ++k) {
+        const dpapprox_dwell &d = p.dwell[k];
+        config.dwell_time_cons.emplace_back(std::vector<int>(d.sequence, d.sequence + d.sequence_length),
+                                            std::vector<double>(d.min_dwell, d.min_dwell + f.n_inputs));
+        if (d.init)
+            config.dwell_time_init.emplace_back(d.init, d.init + f.n_inputs);
+    }
+    if (!config.dwell_time_init.empty() && config.dwell_time_init.size() != p.n_dwell)
+        throw std::invalid_argument("Error: init must be given for all or none of the dwell constraints.");
+
+    void *user = p.user_data;
+    const std::size_t dim = p.cost_dim;
+    if (p.stage_cost) {
+        auto fn = p.stage_cost;
+        config.stage_cost = [fn, user, dim](const ProblemConfig::disc_vector &vi, const std::vector<double> &ri,
+                                            int i, double dt) {
+            std::vector<double> out(dim);
+            check(fn(vi.data(), ri.data(), vi.size(), i, dt, out.data(), dim, user), "stage_cost");
+            return out;
+        };
+    }
+    if (p.objective) {
+        auto fn = p.objective;
+        config.objective = [fn, user](const std::vector<double> &x) { return fn(x.data(), x.size(), user); };
+    }
+
+    config.include_state = (p.include_state != 0);
+    if (p.x0)
+        config.x0.assign(p.x0, p.x0 + p.nx);
+    if (p.state_transition) {
+        auto fn = p.state_transition;
+        config.state_transition = [fn, user](const ProblemConfig::traj_vector &xi, const ProblemConfig::disc_vector &vi,
+                                             int i, double dt) {
+            ProblemConfig::traj_vector out(xi.size());
+            check(fn(xi.data(), xi.size(), vi.data(), vi.size(), i, dt, out.data(), user), "state_transition");
+            return out;
+        };
+    }
+    if (p.state_cost) {
+        auto fn = p.state_cost;
+        config.state_cost = [fn, user, dim](const ProblemConfig::traj_vector &xi, const std::vector<double> &ri,
+                                            int i, double dt) {
+            std::vector<double> out(dim);
+            check(fn(xi.data(), xi.size(), ri.data(), ri.size(), i, dt, out.data(), dim, user), "state_cost");
+            return out;
+        };
+    }
+
+    config.engine = (p.engine == DPAPPROX_ENGINE_STATE_GRAPH) ? ProblemConfig::Engine::StateGraph
+                                                                : ProblemConfig::Engine::Labels;
+    return config;
+}
+
+RelaxedView view_of(const dpapprox_matrix &m) {
+    return RelaxedView(m.data, m.rows, m.cols, m.row_stride, m.col_stride);
+}
+
+bool fits(const dpapprox_buffer &b, std::size_t rows, std::size_t cols) {
+    return b.data != nullptr && b.rows >= rows && b.cols >= cols;
+}
+
+}
+
+extern "C" {
+
+unsigned dpapprox_abi_version(void) {
+    return DPAPPROX_ABI_VERSION;
+}
+
+const char *dpapprox_last_error(void) {
+    return last_error.c_str();
+}
+
+dpapprox_status dpapprox_solver_create(const dpapprox_problem *problem, const dpapprox_matrix *v_rel,
+                                       dpapprox_solver **solver) {
+    if (!problem || !v_rel || !solver || !v_rel->data)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: null argument.");
+    if (problem->struct_size < sizeof(problem->struct_size))
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: dpapprox_problem.struct_size is not set.");
+    const dpapprox_problem p = fitted(*problem);
+    if (!p.feasible.values)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: null argument.");
+    if (p.N < 1 || p.feasible.n_inputs == 0 || p.cost_dim == 0)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: N, n_inputs and cost_dim must be positive.");
+    if (!valid_feasible(p.feasible, p.N))
+        return fail(DPAPPROX_ERROR_ARGUMENT,
+                    "Error: node_offsets must be increasing and at most n_values, with a value at every node.");
+    if (v_rel->cols != static_cast<std::size_t>(p.N))
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: N does not match v_rel.cols.");
+    if (v_rel->rows != p.feasible.n_inputs)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: n_inputs does not match v_rel.rows.");
+
+    *solver = nullptr;
+    return guard([&] {
+        auto s = std::make_unique<dpapprox_solver>();
+        s->n_inputs = p.feasible.n_inputs;
+        s->N = p.N;
+        auto config = std::make_shared<const ProblemConfig>(make_config(p));
+        s->solver = std::make_unique<Solver>(view_of(*v_rel), config);
+        *solver = s.release();
+        return DPAPPROX_OK;
+    });
+}
+
+dpapprox_status dpapprox_solver_reset(dpapprox_solver *solver, const dpapprox_matrix *v_rel) {
+    if (!solver || !v_rel || !v_rel->data)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: null argument.");
+    if (v_rel->cols != static_cast<std::size_t>(solver->N))
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: N does not match v_rel.cols.");
+    if (v_rel->rows != solver->n_inputs)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: n_inputs does not match v_rel.rows.");
+    return guard([&] {
+        solver->solved = false;
+        solver->solver->reset(view_of(*v_rel));
+        return DPAPPROX_OK;
+    });
+}
+
+dpapprox_status dpapprox_solver_solve(dpapprox_solver *solver) {
+    if (!solver)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: null solver.");
+    return guard([&] {
+        solver->solved = false;
+        solver->solver->solve();
+        solver->solved = true;
+        return DPAPPROX_OK;
+    });
+}
+
+dpapprox_status dpapprox_solver_result(const dpapprox_solver *solver, dpapprox_result *result) {
+    if (!solver || !result)
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: null argument.");
+    if (result->struct_size < sizeof(result->struct_size))
+        return fail(DPAPPROX_ERROR_ARGUMENT, "Error: dpapprox_result.struct_size is not set.");
+    if (!solver->solved)
+        return fail(DPAPPROX_ERROR_NOT_SOLVED, "Error: solve has not completed.");
+
+    dpapprox_result out = fitted(*result);
+    const Solution &sol = solver->solver->solution;
+    const std::size_t N = sol.optimum_path.size();
+    if (!fits(out.path, solver->n_inputs, N) || out.cost_capacity < sol.cost.size() ||
+        (sol.cost.size() > 0 && !out.cost))
+        return fail(DPAPPROX_ERROR_BUFFER, "Error: result buffers are too small.");
+
+    const dpapprox_buffer &path = out.path;
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t r = 0; r < solver->n_inputs; ++r)
+            path.data[r * path.row_stride + i * path.col_stride] = sol.optimum_path[i][r];
+
+    const dpapprox_buffer &traj = out.traj;
+    if (traj.data && !sol.optimum_traj.empty()) {
+        const std::size_t nx = sol.optimum_traj[0].size();
+        if (!fits(traj, nx, sol.optimum_traj.size()))
+            return fail(DPAPPROX_ERROR_BUFFER, "Error: result buffers are too small.");
+        for (std::size_t i = 0; i < sol.optimum_traj.size(); ++i)
+            for (std::size_t r = 0; r < nx; ++r)
+                traj.data[r * traj.row_stride + i * traj.col_stride] = sol.optimum_traj[i][r];
+    }
+
+    std::copy(sol.cost.begin(), sol.cost.end(), out.cost);
+    out.cost_dim = sol.cost.size();
+    out.objective = sol.objective;
+    out.success = sol.success ? 1 : 0;
+    out.status = static_cast<dpapprox_solve_status>(sol.status);
+    out.last_node = sol.last_node;
+    write_fitted(out, *result);
+    return DPAPPROX_OK;
+}
+
+void dpapprox_solver_destroy(dpapprox_solver *solver) {
+    delete solver;
+}
+
+}
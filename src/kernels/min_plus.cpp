@@ -0,0 +1,301 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "min_plus.h"
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DPAPPROX_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace DPapprox::kernels {
+
+namespace {
+
+template<class T>
+constexpr T INF = std::numeric_limits<T>::infinity();
+
+/*
+ * Best candidate of one successor row. The vector kernels keep one of these per lane and merge them with [merge],
+ * which prefers the lower index on equal keys so that the first minimizer always wins, as in the scalar loop.
+ */
+template<class T>
+struct Best {
+    T key{INF<T>};
+    T val{0};
+    std::size_t idx;
+};
+
+template<class T>
+inline void merge(Best<T> &best, T key, T val, std::size_t idx) {
+    if (key < best.key || (key == best.key && idx < best.idx)) {
+        best.key = key;
+        best.val = val;
+        best.idx = idx;
+    }
+}
+
+template<class T>
+inline void scalar_tail(const T *V, const T *row, T cj, std::size_t k, std::size_t n_pred,
+                        MinPlusOp op, Best<T> &best) {
+    for (; k < n_pred; ++k) {
+        T s = V[k] + (cj + row[k]);
+        T key = (op == MinPlusOp::Absolute) ? std::fabs(s) : s;
+        if (key < best.key) {
+            best.key = key;
+            best.val = s;
+            best.idx = k;
+        }
+    }
+}
+
+template<class T>
+inline void write(const Best<T> &best, std::size_t n_pred, T *cost, std::size_t *arg) {
+    *arg = (best.key < INF<T>) ? best.idx : n_pred;
+    *cost = best.val;
+}
+
+template<class T>
+void min_plus_scalar(const T *V, std::size_t n_pred, const T *c, const T *pen, std::size_t n_succ,
+                     MinPlusOp op, T *cost, std::size_t *arg) {
+    for (std::size_t j = 0; j < n_succ; ++j) {
+        Best<T> best{INF<T>, 0, n_pred};
+        scalar_tail(V, pen + j * n_pred, c[j], 0, n_pred, op, best);
+        write(best, n_pred, cost + j, arg + j);
+    }
+}
+
+#ifdef DPAPPROX_X86_KERNELS
+
+__attribute__((target("avx2")))
+void min_plus_avx2(const double *V, std::size_t n_pred, const double *c, const double *pen, std::size_t n_succ,
+                   MinPlusOp op, double *cost, std::size_t *arg) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+    const bool absolute = (op == MinPlusOp::Absolute);
+    const std::size_t n_vec = n_pred - n_pred % 4;
+
+    for (std::size_t j = 0; j < n_succ; ++j) {
+        const double *row = pen + j * n_pred;
+        const __m256d cj = _mm256_set1_pd(c[j]);
+        __m256d best_key = _mm256_set1_pd(INF<double>);
+        __m256d best_val = _mm256_setzero_pd();
+        __m256d best_idx = _mm256_set1_pd(static_cast<double>(n_pred));
+        __m256d idx = _mm256_setr_pd(0, 1, 2, 3);
+
+        for (std::size_t k = 0; k < n_vec; k += 4) {
+            __m256d s = _mm256_add_pd(_mm256_loadu_pd(V + k), _mm256_add_pd(cj, _mm256_loadu_pd(row + k)));
+            __m256d key = absolute ? _mm256_andnot_pd(sign, s) : s;
+            __m256d lt = _mm256_cmp_pd(key, best_key, _CMP_LT_OQ);
+            best_key = _mm256_blendv_pd(best_key, key, lt);
+            best_val = _mm256_blendv_pd(best_val, s, lt);
+            best_idx = _mm256_blendv_pd(best_idx, idx, lt);
+            idx = _mm256_add_pd(idx, step);
+        }
+
+        alignas(32) double keys[4], vals[4], idxs[4];
+        _mm256_store_pd(keys, best_key);
+        _mm256_store_pd(vals, best_val);
+        _mm256_store_pd(idxs, best_idx);
+        Best<double> best{INF<double>, 0, n_pred};
+        for (int l = 0; l < 4; ++l)
+            merge(best, keys[l], vals[l], static_cast<std::size_t>(idxs[l]));
+
+        scalar_tail(V, row, c[j], n_vec, n_pred, op, best);
+        write(best, n_pred, cost + j, arg + j);
+    }
+}
+
+__attribute__((target("avx512f")))
+void min_plus_avx512(const double *V, std::size_t n_pred, const double *c, const double *pen, std::size_t n_succ,
+                     MinPlusOp op, double *cost, std::size_t *arg) {
+    const __m512d step = _mm512_set1_pd(8.0);
+    const bool absolute = (op == MinPlusOp::Absolute);
+    const std::size_t n_vec = n_pred - n_pred % 8;
+
+    for (std::size_t j = 0; j < n_succ; ++j) {
+        const double *row = pen + j * n_pred;
+        const __m512d cj = _mm512_set1_pd(c[j]);
+        __m512d best_key = _mm512_set1_pd(INF<double>);
+        __m512d best_val = _mm512_setzero_pd();
+        __m512d best_idx = _mm512_set1_pd(static_cast<double>(n_pred));
+        __m512d idx = _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (std::size_t k = 0; k < n_vec; k += 8) {
+            __m512d s = _mm512_add_pd(_mm512_loadu_pd(V + k), _mm512_add_pd(cj, _mm512_loadu_pd(row + k)));
+            __m512d key = absolute ? _mm512_abs_pd(s) : s;
+            __mmask8 lt = _mm512_cmp_pd_mask(key, best_key, _CMP_LT_OQ);
+            best_key = _mm512_mask_blend_pd(lt, best_key, key);
+            best_val = _mm512_mask_blend_pd(lt, best_val, s);
+            best_idx = _mm512_mask_blend_pd(lt, best_idx, idx);
+            idx = _mm512_add_pd(idx, step);
+        }
+
+        alignas(64) double keys[8], vals[8], idxs[8];
+        _mm512_store_pd(keys, best_key);
+        _mm512_store_pd(vals, best_val);
+        _mm512_store_pd(idxs, best_idx);
+        Best<double> best{INF<double>, 0, n_pred};
+        for (int l = 0; l < 8; ++l)
+            merge(best, keys[l], vals[l], static_cast<std::size_t>(idxs[l]));
+
+        scalar_tail(V, row, c[j], n_vec, n_pred, op, best);
+        write(best, n_pred, cost + j, arg + j);
+    }
+}
+
+// the float kernels run twice the lanes. the lane indices are floats too, exact below 2^24 predecessors, beyond which
+// min_plus falls back to the scalar loop.
+__attribute__((target("avx2")))
+void min_plus_avx2(const float *V, std::size_t n_pred, const float *c, const float *pen, std::size_t n_succ,
+                   MinPlusOp op, float *cost, std::size_t *arg) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 step = _mm256_set1_ps(8.0f);
+    const bool absolute = (op == MinPlusOp::Absolute);
+    const std::size_t n_vec = n_pred - n_pred % 8;
+
+    for (std::size_t j = 0; j < n_succ; ++j) {
+        const float *row = pen + j * n_pred;
+        const __m256 cj = _mm256_set1_ps(c[j]);
+        __m256 best_key = _mm256_set1_ps(INF<float>);
+        __m256 best_val = _mm256_setzero_ps();
+        __m256 best_idx = _mm256_set1_ps(static_cast<float>(n_pred));
+        __m256 idx = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (std::size_t k = 0; k < n_vec; k += 8) {
+            __m256 s = _mm256_add_ps(_mm256_loadu_ps(V + k), _mm256_add_ps(cj, _mm256_loadu_ps(row + k)));
+            __m256 key = absolute ? _mm256_andnot_ps(sign, s) : s;
+            __m256 lt = _mm256_cmp_ps(key, best_key, _CMP_LT_OQ);
+            best_key = _mm256_blendv_ps(best_key, key, lt);
+            best_val = _mm256_blendv_ps(best_val, s, lt);
+            best_idx = _mm256_blendv_ps(best_idx, idx, lt);
+            idx = _mm256_add_ps(idx, step);
+        }
+
+        alignas(32) float keys[8], vals[8], idxs[8];
+        _mm256_store_ps(keys, best_key);
+        _mm256_store_ps(vals, best_val);
+        _mm256_store_ps(idxs, best_idx);
+        Best<float> best{INF<float>, 0, n_pred};
+        for (int l = 0; l < 8; ++l)
+            merge(best, keys[l], vals[l], static_cast<std::size_t>(idxs[l]));
+
+        scalar_tail(V, row, c[j], n_vec, n_pred, op, best);
+        write(best, n_pred, cost + j, arg + j);
+    }
+}
+
+__attribute__((target("avx512f")))
+void min_plus_avx512(const float *V, std::size_t n_pred, const float *c, const float *pen, std::size_t n_succ,
+                     MinPlusOp op, float *cost, std::size_t *arg) {
+    const __m512 step = _mm512_set1_ps(16.0f);
+    const bool absolute = (op == MinPlusOp::Absolute);
+    const std::size_t n_vec = n_pred - n_pred % 16;
+
+    for (std::size_t j = 0; j < n_succ; ++j) {
+        const float *row = pen + j * n_pred;
+        const __m512 cj = _mm512_set1_ps(c[j]);
+        __m512 best_key = _mm512_set1_ps(INF<float>);
+        __m512 best_val = _mm512_setzero_ps();
+        __m512 best_idx = _mm512_set1_ps(static_cast<float>(n_pred));
+        __m512 idx = _mm512_setr_ps(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        for (std::size_t k = 0; k < n_vec; k += 16) {
+            __m512 s = _mm512_add_ps(_mm512_loadu_ps(V + k), _mm512_add_ps(cj, _mm512_loadu_ps(row + k)));
+            __m512 key = absolute ? _mm512_abs_ps(s) : s;
+            __mmask16 lt = _mm512_cmp_ps_mask(key, best_key, _CMP_LT_OQ);
+            best_key = _mm512_mask_blend_ps(lt, best_key, key);
+            best_val = _mm512_mask_blend_ps(lt, best_val, s);
+            best_idx = _mm512_mask_blend_ps(lt, best_idx, idx);
+            idx = _mm512_add_ps(idx, step);
+        }
+
+        alignas(64) float keys[16], vals[16], idxs[16];
+        _mm512_store_ps(keys, best_key);
+        _mm512_store_ps(vals, best_val);
+        _mm512_store_ps(idxs, best_idx);
+        Best<float> best{INF<float>, 0, n_pred};
+        for (int l = 0; l < 16; ++l)
+            merge(best, keys[l], vals[l], static_cast<std::size_t>(idxs[l]));
+
+        scalar_tail(V, row, c[j], n_vec, n_pred, op, best);
+        write(best, n_pred, cost + j, arg + j);
+    }
+}
+
+bool supported(MinPlusIsa isa) {
+    switch (isa) {
+        case MinPlusIsa::AVX512: return __builtin_cpu_supports("avx512f");
+        case MinPlusIsa::AVX2:   return __builtin_cpu_supports("avx2");
+        default:                 return true;
+    }
+}
+
+#else
+
+bool supported(MinPlusIsa isa) {
+    return isa == MinPlusIsa::Scalar;
+}
+
+#endif
+
+MinPlusIsa select_isa() {
+    if (supported(MinPlusIsa::AVX512)) return MinPlusIsa::AVX512;
+    if (supported(MinPlusIsa::AVX2)) return MinPlusIsa::AVX2;
+    return MinPlusIsa::Scalar;
+}
+
+}
+
+MinPlusIsa min_plus_isa() {
+    static const MinPlusIsa isa = select_isa();
+    return isa;
+}
+
+namespace {
+
+template<class T>
+void dispatch(const T *V, std::size_t n_pred, const T *c, const T *pen, std::size_t n_succ,
+              MinPlusOp op, T *cost, std::size_t *arg, MinPlusIsa isa) {
+    if (!supported(isa) || (sizeof(T) == sizeof(float) && n_pred >= (std::size_t{1} << 24)))
+        isa = MinPlusIsa::Scalar;
+#ifdef DPAPPROX_X86_KERNELS
+    if (isa == MinPlusIsa::AVX512)
+        return min_plus_avx512(V, n_pred, c, pen, n_succ, op, cost, arg);
+    if (isa == MinPlusIsa::AVX2)
+        return min_plus_avx2(V, n_pred, c, pen, n_succ, op, cost, arg);
+#endif
+    min_plus_scalar(V, n_pred, c, pen, n_succ, op, cost, arg);
+}
+
+}
+
+void min_plus(const double *V, std::size_t n_pred, const double *c, const double *pen, std::size_t n_succ,
+              MinPlusOp op, double *cost, std::size_t *arg) {
+    dispatch(V, n_pred, c, pen, n_succ, op, cost, arg, min_plus_isa());
+}
+
+void min_plus(const double *V, std::size_t n_pred, const double *c, const double *pen, std::size_t n_succ,
+              MinPlusOp op, double *cost, std::size_t *arg, MinPlusIsa isa) {
+    dispatch(V, n_pred, c, pen, n_succ, op, cost, arg, isa);
+}
+
+void min_plus(const float *V, std::size_t n_pred, const float *c, const float *pen, std::size_t n_succ,
+              MinPlusOp op, float *cost, std::size_t *arg) {
+    dispatch(V, n_pred, c, pen, n_succ, op, cost, arg, min_plus_isa());
+}
+
+void min_plus(const float *V, std::size_t n_pred, const float *c, const float *pen, std::size_t n_succ,
+              MinPlusOp op, float *cost, std::size_t *arg, MinPlusIsa isa) {
+    dispatch(V, n_pred, c, pen, n_succ, op, cost, arg, isa);
+}
+
+}
@@ -0,0 +1,106 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "memo_cache.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace DPapprox {
+
+MemoCache::MemoCache(std::pmr::memory_resource *resource)
+    : _keys(resource), _values(resource), _key(resource) {}
+
+void MemoCache::reset(std::size_t capacity, std::size_t nx, double quantum) {
+    const std::size_t slots = std::bit_ceil(std::max<std::size_t>(capacity, PROBES));
+    _nx = nx;
+    _quantum = quantum;
+    _mask = slots - 1;
+    _width = 0;
+    _values.clear();
+    _key.resize(nx + 2);
+    _keys.assign(slots * (nx + 2), 0);
+    clear();
+    _stats = MemoStats{};
+}
+
+void MemoCache::clear() {
+    const std::size_t stride = _nx + 2;
+    for (std::size_t slot = 0; slot <= _mask && !_keys.empty(); ++slot)
+        _keys[slot * stride] = -1;
+}
+
+const double *MemoCache::find(int node, std::size_t input, const double *x) {
+    _quantize(node, input, x);
+    const std::size_t home = _hash();
+    for (std::size_t p = 0; p < PROBES; ++p) {
+        const std::size_t slot = (home + p) & _mask;
+        if (_keys[slot * (_nx + 2)] < 0)
+            break;
+        if (_match(slot)) {
+            ++_stats.hits;
+            return _values.data() + slot * _width;
+        }
+    }
+    ++_stats.misses;
+    return nullptr;
+}
+
+void MemoCache::insert(int node, std::size_t input, const double *x, const double *value, std::size_t n) {
+    if (_width == 0) {
+        _width = n;
+        _values.assign((_mask + 1) * n, 0.0);
+    }
+    if (n != _width || n == 0)
+        return;
+
+    _quantize(node, input, x);
+    const std::size_t home = _hash(), stride = _nx + 2;
+    std::size_t slot = home;
+    for (std::size_t p = 0; p < PROBES; ++p) {
+        const std::size_t s = (home + p) & _mask;
+        if (_keys[s * stride] < 0 || _match(s)) {
+            slot = s;
+            break;
+        }
+        if (p + 1 == PROBES)
+            ++_stats.evictions;
+    }
+    std::copy(_key.begin(), _key.end(), _keys.begin() + slot * stride);
+    std::copy(value, value + n, _values.begin() + slot * _width);
+}
+
+void MemoCache::_quantize(int node, std::size_t input, const double *x) {
+    // a state beyond the range of the grid keeps its bit pattern.
+    _key[0] = node;
+    _key[1] = static_cast<std::int64_t>(input);
+    for (std::size_t k = 0; k < _nx; ++k) {
+        const double q = (_quantum > 0) ? std::nearbyint(x[k] / _quantum) : 0.0;
+        if (_quantum > 0 && std::abs(q) < 9e18)
+            _key[k + 2] = static_cast<std::int64_t>(q);
+        else
+            std::memcpy(&_key[k + 2], x + k, sizeof(double));
+    }
+}
+
+std::size_t MemoCache::_hash() const {
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (std::int64_t word: _key) {
+        h ^= static_cast<std::uint64_t>(word) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h = (h ^ (h >> 31)) * 0xbf58476d1ce4e5b9ULL;
+    }
+    return static_cast<std::size_t>(h ^ (h >> 29)) & _mask;
+}
+
+bool MemoCache::_match(std::size_t slot) const {
+    return std::equal(_key.begin(), _key.end(), _keys.begin() + slot * (_nx + 2));
+}
+
+}
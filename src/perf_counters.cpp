@@ -0,0 +1,121 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "perf_counters.h"
+#include "logger.h"
+#include <algorithm>
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace DPapprox {
+
+PerfSample &PerfSample::operator+=(const PerfSample &other) {
+    for (std::size_t e = 0; e < EVENTS; ++e) {
+        count[e] += other.count[e];
+        valid[e] = valid[e] || other.valid[e];
+    }
+    return *this;
+}
+
+const char *PerfSample::name(Event event) {
+    static const char *names[] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+                                  "page_faults"};
+    return names[event];
+}
+
+#ifdef __linux__
+
+namespace {
+
+int open_event(std::uint32_t type, std::uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // the threads started afterwards, e.g. by Solver::sweep and separable solves, are counted too.
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // the calling thread on any cpu.
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}
+
+PerfCounters::PerfCounters() {
+    constexpr std::uint64_t l1d_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    _fd[PerfSample::Cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    _fd[PerfSample::Instructions] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    _fd[PerfSample::L1DMisses] = open_event(PERF_TYPE_HW_CACHE, l1d_miss);
+    _fd[PerfSample::LLCMisses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    _fd[PerfSample::BranchMisses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    _fd[PerfSample::PageFaults] = open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+    if (!available())
+        DPapprox::Log.log(WARNING) << "No performance counters available." << std::endl;
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd: _fd)
+        if (fd >= 0)
+            ::close(fd);
+}
+
+PerfSample PerfCounters::read() const {
+    PerfSample sample;
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e) {
+        std::uint64_t value[3];
+        if (_fd[e] < 0 || ::read(_fd[e], value, sizeof(value)) != sizeof(value))
+            continue;
+        // value, time enabled and time running: a multiplexed counter is extrapolated to the time it was enabled.
+        sample.count[e] = (value[2] > 0 && value[2] < value[1])
+                          ? static_cast<std::uint64_t>(static_cast<double>(value[0]) * value[1] / value[2])
+                          : value[0];
+        sample.valid[e] = true;
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+    _fd.fill(-1);
+    DPapprox::Log.log(WARNING) << "No performance counters available." << std::endl;
+}
+
+PerfCounters::~PerfCounters() = default;
+
+PerfSample PerfCounters::read() const {
+    return PerfSample{};
+}
+
+#endif
+
+bool PerfCounters::available() const {
+    return std::any_of(_fd.begin(), _fd.end(), [](int fd) { return fd >= 0; });
+}
+
+PerfSample PerfCounters::since(const PerfSample &start) const {
+    PerfSample sample = read();
+    for (std::size_t e = 0; e < PerfSample::EVENTS; ++e) {
+        // scaled counts may step back by rounding.
+        sample.count[e] = (sample.valid[e] && start.valid[e] && sample.count[e] > start.count[e])
+                          ? sample.count[e] - start.count[e] : 0;
+        sample.valid[e] = sample.valid[e] && start.valid[e];
+    }
+    return sample;
+}
+
+}
@@ -0,0 +1,237 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "policy.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace DPapprox {
+
+namespace {
+
+constexpr char MAGIC[8] = {'D', 'P', 'P', 'O', 'L', 'I', 'C', 'Y'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t ENDIAN = 0x01020304;
+
+std::uint64_t align(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t{7};
+}
+
+// whether the section at [offset] of the product of [counts] elements of [bytes] lies in an image of [size] bytes,
+// aligned as written by from_tables.
+bool section_fits(std::uint64_t offset, std::initializer_list<std::int64_t> counts, std::uint64_t bytes,
+                  std::uint64_t size) {
+    if (offset % 8 != 0 || offset > size)
+        return false;
+    std::uint64_t length = bytes;
+    for (std::int64_t n: counts) {
+        if (n < 0)
+            return false;
+        if (n > 0 && length > (size - offset) / static_cast<std::uint64_t>(n))
+            return false;
+        length *= static_cast<std::uint64_t>(n);
+    }
+    return length <= size - offset;
+}
+
+template<class T>
+void put(std::vector<std::byte> &image, std::uint64_t offset, const T *data, std::size_t n) {
+    if (n > 0)
+        std::memcpy(image.data() + offset, data, n * sizeof(T));
+}
+
+}
+
+Policy Policy::from_tables(int N, const std::vector<ProblemConfig::disc_vector> &values, std::size_t slots,
+                           const std::vector<int> &state_value, const std::vector<int> &state_steps,
+                           const std::vector<std::int32_t> &next, const std::vector<double> &cost,
+                           std::int32_t start) {
+    const std::size_t S = state_value.size();
+    const std::size_t nv = values.empty() ? 0 : values[0].size();
+    if (state_steps.size() != S * slots || next.size() != N * S || cost.size() != N * S)
+        throw std::runtime_error("Error: policy tables have inconsistent sizes.");
+
+    // the steps of every slot are keyed in mixed radix, so that a state is found by one index.
+    std::vector<std::int32_t> radix(slots, 1);
+    for (std::size_t s = 0; s < S; ++s)
+        for (std::size_t k = 0; k < slots; ++k)
+            radix[k] = std::max(radix[k], state_steps[s * slots + k] + 1);
+    std::size_t n_keys = 1;
+    for (std::int32_t r: radix)
+        n_keys *= static_cast<std::size_t>(r);
+
+    std::vector<std::int32_t> index(values.size() * n_keys, -1);
+    for (std::size_t s = 0; s < S; ++s) {
+        std::size_t key = 0;
+        for (std::size_t k = slots; k-- > 0;)
+            key = key * radix[k] + state_steps[s * slots + k];
+        index[state_value[s] * n_keys + key] = static_cast<std::int32_t>(s);
+    }
+
+    PolicyHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endian = ENDIAN;
+    header.N = N;
+    header.n_values = static_cast<std::int64_t>(values.size());
+    header.nv = static_cast<std::int64_t>(nv);
+    header.slots = static_cast<std::int64_t>(slots);
+    header.n_states = static_cast<std::int64_t>(S);
+    header.n_keys = static_cast<std::int64_t>(n_keys);
+    header.start = start;
+    header.values = align(sizeof(PolicyHeader));
+    header.radix = align(header.values + values.size() * nv * sizeof(double));
+    header.index = align(header.radix + slots * sizeof(std::int32_t));
+    header.state_value = align(header.index + index.size() * sizeof(std::int32_t));
+    header.state_steps = align(header.state_value + S * sizeof(std::int32_t));
+    header.next = align(header.state_steps + S * slots * sizeof(std::int32_t));
+    header.cost = align(header.next + next.size() * sizeof(std::int32_t));
+    header.size = align(header.cost + cost.size() * sizeof(double));
+
+    Policy policy;
+    policy._owned.assign(header.size, std::byte{0});
+    put(policy._owned, 0, &header, 1);
+    for (std::size_t u = 0; u < values.size(); ++u)
+        put(policy._owned, header.values + u * nv * sizeof(double), values[u].data(), nv);
+    put(policy._owned, header.radix, radix.data(), radix.size());
+    put(policy._owned, header.index, index.data(), index.size());
+    std::vector<std::int32_t> narrow(state_value.begin(), state_value.end());
+    put(policy._owned, header.state_value, narrow.data(), narrow.size());
+    narrow.assign(state_steps.begin(), state_steps.end());
+    put(policy._owned, header.state_steps, narrow.data(), narrow.size());
+    put(policy._owned, header.next, next.data(), next.size());
+    put(policy._owned, header.cost, cost.data(), cost.size());
+    policy._attach(policy._owned.data());
+    return policy;
+}
+
+Policy Policy::load(const std::string &filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Error: Cannot open file " + filename + ".");
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(PolicyHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Error: " + filename + " is not a policy file.");
+    }
+
+    Policy policy;
+    policy._map_size = static_cast<std::size_t>(st.st_size);
+    policy._map = ::mmap(nullptr, policy._map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (policy._map == MAP_FAILED) {
+        policy._map = nullptr;
+        throw std::runtime_error("Error: Cannot map file " + filename + ".");
+    }
+
+    const auto *header = static_cast<const PolicyHeader *>(policy._map);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+        header->endian != ENDIAN || header->size > policy._map_size)
+        throw std::runtime_error("Error: " + filename + " is not a compatible policy file.");
+
+    // every section must lie within the image for the sizes given by the counts of the header, which the lookups
+    // index by.
+    const std::uint64_t size = header->size;
+    const bool fits = header->N >= 0 && header->n_states >= 0 && header->start >= -1 &&
+                      header->start < header->n_states &&
+                      section_fits(header->values, {header->n_values, header->nv}, sizeof(double), size) &&
+                      section_fits(header->radix, {header->slots}, sizeof(std::int32_t), size) &&
+                      section_fits(header->index, {header->n_values, header->n_keys}, sizeof(std::int32_t), size) &&
+                      section_fits(header->state_value, {header->n_states}, sizeof(std::int32_t), size) &&
+                      section_fits(header->state_steps, {header->n_states, header->slots}, sizeof(std::int32_t),
+                                   size) &&
+                      section_fits(header->next, {header->N, header->n_states}, sizeof(std::int32_t), size) &&
+                      section_fits(header->cost, {header->N, header->n_states}, sizeof(double), size);
+    if (!fits)
+        throw std::runtime_error("Error: " + filename + " is a truncated or corrupt policy file.");
+
+    // the keys of state() are bounded by the radix of every slot.
+    const auto *radix = reinterpret_cast<const std::int32_t *>(static_cast<const std::byte *>(policy._map) +
+                                                               header->radix);
+    std::int64_t n_keys = 1;
+    for (std::int64_t k = 0; k < header->slots && n_keys <= header->n_keys; ++k) {
+        if (radix[k] < 1)
+            throw std::runtime_error("Error: " + filename + " is a truncated or corrupt policy file.");
+        n_keys *= radix[k];
+    }
+    if (n_keys != header->n_keys)
+        throw std::runtime_error("Error: " + filename + " is a truncated or corrupt policy file.");
+    policy._attach(static_cast<const std::byte *>(policy._map));
+    return policy;
+}
+
+void Policy::save(const std::string &filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Error: Cannot open file " + filename + " for writing.");
+    file.write(reinterpret_cast<const char *>(_header), static_cast<std::streamsize>(_header->size));
+    if (!file)
+        throw std::runtime_error("Error: Cannot write file " + filename + ".");
+}
+
+Policy::Policy(Policy &&other) noexcept {
+    *this = std::move(other);
+}
+
+Policy &Policy::operator=(Policy &&other) noexcept {
+    if (this != &other) {
+        if (_map)
+            ::munmap(_map, _map_size);
+        _owned = std::move(other._owned);
+        _map = other._map;
+        _map_size = other._map_size;
+        other._map = nullptr;
+        other._map_size = 0;
+        // the views are attached again to the image, which keeps its address in both cases.
+        _header = nullptr;
+        if (other._header)
+            _attach(_map ? static_cast<const std::byte *>(_map) : _owned.data());
+        other._header = nullptr;
+    }
+    return *this;
+}
+
+Policy::~Policy() {
+    if (_map)
+        ::munmap(_map, _map_size);
+}
+
+ProblemConfig::disc_vector Policy::value(std::size_t u) const {
+    return {_values + u * _header->nv, _values + (u + 1) * _header->nv};
+}
+
+std::int32_t Policy::state(std::size_t u, const int *steps) const {
+    std::size_t key = 0;
+    for (std::size_t k = slots(); k-- > 0;) {
+        if (steps[k] < 0 || steps[k] >= _radix[k])
+            return -1;
+        key = key * _radix[k] + steps[k];
+    }
+    return _index[u * _header->n_keys + key];
+}
+
+void Policy::_attach(const std::byte *data) {
+    _header = reinterpret_cast<const PolicyHeader *>(data);
+    _values = reinterpret_cast<const double *>(data + _header->values);
+    _radix = reinterpret_cast<const std::int32_t *>(data + _header->radix);
+    _index = reinterpret_cast<const std::int32_t *>(data + _header->index);
+    _state_value = reinterpret_cast<const std::int32_t *>(data + _header->state_value);
+    _state_steps = reinterpret_cast<const std::int32_t *>(data + _header->state_steps);
+    _next = reinterpret_cast<const std::int32_t *>(data + _header->next);
+    _cost = reinterpret_cast<const double *>(data + _header->cost);
+}
+
+}
@@ -0,0 +1,370 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "state_graph.h"
+#include <map>
+#include <deque>
+#include <stdexcept>
+
+namespace DPapprox {
+
+StateGraph::StateGraph(const ProblemConfig &config) : _dp(config) {
+    if (_dp.dt <= 0)
+        throw std::runtime_error("Error: StateGraph requires a positive dt.");
+
+    // collect the distinct feasible values, and which of them are feasible at each node.
+    std::map<ProblemConfig::disc_vector, int> value_index;
+    _feasible.resize(_dp.N);
+    for (int i = 0; i < _dp.N; ++i) {
+        for (const ProblemConfig::disc_vector &v: _dp.v_feasible[i]) {
+            auto it = value_index.try_emplace(v, static_cast<int>(_values.size())).first;
+            if (it->second == static_cast<int>(_values.size()))
+                _values.push_back(v);
+        }
+        _feasible[i].assign(_values.size(), 0);
+        for (const ProblemConfig::disc_vector &v: _dp.v_feasible[i])
+            _feasible[i][value_index.at(v)] = 1;
+    }
+    for (auto &feasible: _feasible)
+        feasible.resize(_values.size(), 0);
+
+    const std::size_t nv = _values.at(0).size();
+    _slots = _dp.dwell_time_cons.size() * nv;
+
+    std::vector<int> init(_slots, 0);
+    _fresh.resize(_slots);
+    for (std::size_t k = 0; k < _dp.dwell_time_cons.size(); ++k) {
+        for (std::size_t idx = 0; idx < nv; ++idx) {
+            _fresh[k * nv + idx] = _steps(_dp.dwell_time_cons[k].second.at(idx) + EPSILON);
+            if (!_dp.dwell_time_init.empty())
+                init[k * nv + idx] = _steps(_dp.dwell_time_init.at(k).at(idx));
+        }
+    }
+
+    // states are enumerated breadth first from the initial timers, keyed by <value, steps...>.
+    std::map<std::vector<int>, std::uint32_t> state_index;
+    std::deque<std::uint32_t> queue;
+    auto state_of = [&](int u, const int *steps) {
+        std::vector<int> key{u};
+        key.insert(key.end(), steps, steps + _slots);
+        auto [it, inserted] = state_index.try_emplace(key, static_cast<std::uint32_t>(_state_value.size()));
+        if (inserted) {
+            _state_value.push_back(u);
+            _state_steps.insert(_state_steps.end(), steps, steps + _slots);
+            queue.push_back(it->second);
+        }
+        return it->second;
+    };
+
+    for (const ProblemConfig::disc_vector &v_0: _dp.v_feasible[0])
+        state_of(value_index.at(v_0), init.data());
+    _n_init = size();
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges; // <target, source>
+    std::vector<int> next(_slots);
+    while (!queue.empty()) {
+        std::uint32_t s = queue.front();
+        queue.pop_front();
+        for (int w = 0; w < static_cast<int>(_values.size()); ++w) {
+            if (_dp.allowed_transition && !_dp.allowed_transition(_values[_state_value[s]], _values[w]))
+                continue;
+            std::vector<int> steps(_state_steps.begin() + s * _slots, _state_steps.begin() + (s + 1) * _slots);
+            if (_transition(steps.data(), _state_value[s], w, next.data()))
+                edges.emplace_back(state_of(w, next.data()), s);
+        }
+    }
+
+    // group the transitions by target. sources are visited in increasing order, so a stable sort keeps them sorted.
+    std::stable_sort(edges.begin(), edges.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    _in_offset.assign(size() + 1, 0);
+    _in_source.reserve(edges.size());
+    for (const auto &[t, s]: edges) {
+        ++_in_offset[t + 1];
+        _in_source.push_back(s);
+    }
+    for (std::size_t t = 0; t < size(); ++t)
+        _in_offset[t + 1] += _in_offset[t];
+
+    DPapprox::Log.log(DEBUG) << "State graph: " << size() << " states, " << edges.size() << " transitions."
+                             << std::endl;
+}
+
+Solution StateGraph::solve(const RelaxedView &v_rel) const {
+    const int N = _dp.N;
+    const std::size_t S = size();
+    const std::size_t nx = _dp.x0.size();
+
+    // flat per-stage arrays: cost and state of the current and next node, and predecessors of all nodes.
+    std::vector<double> cost, cost_nxt, x, x_nxt;
+    std::vector<char> reached(S, 0), reached_nxt(S, 0);
+    std::vector<std::int32_t> pred(static_cast<std::size_t>(N) * S, -1);
+    std::size_t dim = 0, dim_nxt = 0;
+
+    auto store = [](std::vector<double> &table, std::size_t &table_dim, std::size_t s, std::size_t n_states,
+                    const std::vector<double> &value) {
+        if (table_dim == 0) {
+            table_dim = value.size();
+            table.assign(n_states * table_dim, 0.0);
+        }
+        if (value.size() != table_dim)
+            throw std::runtime_error("Error: costs of one node must have the same size.");
+        std::copy(value.begin(), value.end(), table.begin() + s * table_dim);
+    };
+
+    // the first states are the initial timers of the values feasible at node 0.
+    std::vector<double> col, col_nxt;
+    v_rel.column(0, col);
+    if (_dp.include_state)
+        x.assign(S * nx, 0.0);
+    for (std::size_t s = 0; s < _n_init; ++s) {
+        const ProblemConfig::disc_vector &v_0 = _values[_state_value[s]];
+        store(cost, dim, s, S, _dp.stage_cost(v_0, col, 0, _dp.dt));
+        reached[s] = 1;
+        if (_dp.include_state) {
+            ProblemConfig::traj_vector x_0 = _dp.state_transition(_dp.x0, v_0, 0, _dp.dt);
+            std::copy(x_0.begin(), x_0.end(), x.begin() + s * nx);
+        }
+    }
+
+    std::vector<std::vector<double>> c(_values.size()), p(S);
+    std::vector<double> step, candidate, opt;
+    const double opt_0 = _dp.objective({std::numeric_limits<double>::infinity()});
+
+    Solution::Status status = Solution::Status::Solved;
+    int last = N - 1;
+    for (int i = 0; i < N - 1; ++i) {
+        status = interruption(_dp);
+        if (status != Solution::Status::Solved) {
+            last = i;
+            break;
+        }
+
+        v_rel.column(i + 1, col_nxt);
+        for (std::size_t w = 0; w < _values.size(); ++w)
+            if (_feasible[i + 1][w])
+                c[w] = _dp.stage_cost(_values[w], col_nxt, i + 1, _dp.dt);
+        if (_dp.include_state) {
+            for (std::size_t s = 0; s < S; ++s) {
+                if (!reached[s]) continue;
+                ProblemConfig::traj_vector xi(x.begin() + s * nx, x.begin() + (s + 1) * nx);
+                p[s] = _dp.state_cost(xi, col, i, _dp.dt);
+            }
+        }
+
+        dim_nxt = 0;
+        std::fill(reached_nxt.begin(), reached_nxt.end(), 0);
+        if (_dp.include_state)
+            x_nxt.assign(S * nx, 0.0);
+
+        // every target only reads the previous stage, so targets are independent of each other.
+        bool alive = false;
+        for (std::size_t t = 0; t < S; ++t) {
+            const int w = _state_value[t];
+            if (!_feasible[i + 1][w])
+                continue;
+
+            double best = opt_0;
+            std::int32_t best_s = -1;
+            for (std::uint32_t e = _in_offset[t]; e < _in_offset[t + 1]; ++e) {
+                const std::uint32_t s = _in_source[e];
+                if (!reached[s])
+                    continue;
+
+                const std::vector<double> *stage = &c[w];
+                if (_dp.include_state) {
+                    add(c[w].data(), c[w].size(), p[s].data(), p[s].size(), step);
+                    stage = &step;
+                }
+                if (!_dp.customize) {
+                    add(cost.data() + s * dim, dim, stage->data(), stage->size(), candidate);
+                } else {
+                    std::vector<double> V(cost.begin() + s * dim, cost.begin() + (s + 1) * dim);
+                    std::vector<double> cost_stage = *stage;
+                    candidate = _dp.custom_cost(V, cost_stage, i, _dp.dt);
+                }
+
+                double objective = _dp.objective(candidate);
+                if (objective < best) {
+                    best = objective;
+                    best_s = static_cast<std::int32_t>(s);
+                    opt = candidate;
+                }
+            }
+            if (best_s < 0)
+                continue;
+            alive = alive || (best < INFTY[0]);
+
+            store(cost_nxt, dim_nxt, t, S, opt);
+            reached_nxt[t] = 1;
+            pred[(i + 1) * S + t] = best_s;
+            if (_dp.include_state) {
+                ProblemConfig::traj_vector xi(x.begin() + best_s * nx, x.begin() + (best_s + 1) * nx);
+                ProblemConfig::traj_vector xni = _dp.state_transition(xi, _values[w], i + 1, _dp.dt);
+                std::copy(xni.begin(), xni.end(), x_nxt.begin() + t * nx);
+            }
+        }
+
+        cost.swap(cost_nxt);
+        x.swap(x_nxt);
+        reached.swap(reached_nxt);
+        col.swap(col_nxt);
+        dim = dim_nxt;
+        if (!alive) {
+            status = Solution::Status::Infeasible;
+            last = i + 1;
+            break;
+        }
+    }
+
+    // the best label at the last node, and backtracking over the predecessors.
+    Solution solution{{}, {}, INFTY, _dp.objective(INFTY), false, status, last};
+    std::int32_t s_end = -1;
+    double best = std::numeric_limits<double>::infinity();
+    for (std::size_t s = 0; s < S; ++s) {
+        if (!reached[s]) continue;
+        std::vector<double> V(cost.begin() + s * dim, cost.begin() + (s + 1) * dim);
+        double objective = _dp.objective(V);
+        if (s_end < 0 || objective < best) {
+            best = objective;
+            s_end = static_cast<std::int32_t>(s);
+            solution.cost = V;
+        }
+    }
+    if (s_end < 0) {
+        solution.status = Solution::Status::Infeasible;
+        solution.last_node = -1;
+        return solution;
+    }
+
+    solution.optimum_path.resize(last + 1);
+    for (int i = last, s = s_end; i >= 0; --i) {
+        solution.optimum_path[i] = _values[_state_value[s]];
+        s = pred[i * S + s];
+    }
+    solution.objective = best;
+    solution.success = (solution.objective < INFTY.at(0));
+    if (status == Solution::Status::Solved && !solution.success)
+        solution.status = Solution::Status::Infeasible;
+
+    // the trajectory is replayed along the optimum path, Solver completes it if the DP stopped early.
+    if (_dp.include_state && solution.status == Solution::Status::Solved) {
+        solution.optimum_traj.reserve(N + 1);
+        solution.optimum_traj.push_back(_dp.x0);
+        for (int i = 0; i < N; ++i)
+            solution.optimum_traj.push_back(
+                    _dp.state_transition(solution.optimum_traj.back(), solution.optimum_path[i], i, _dp.dt));
+    }
+    return solution;
+}
+
+Policy StateGraph::policy(const RelaxedView &v_rel) const {
+    const int N = _dp.N;
+    const std::size_t S = size();
+
+    // the cost to go is only optimal, and the same as the forward DP's, when the objective adds up the stage costs.
+    if (_dp.resolved_objective_kind() != ProblemConfig::ObjectiveKind::Identity)
+        throw std::runtime_error("Error: a policy requires an additive objective (ObjectiveKind::Identity, as "
+                                 "default_objective).");
+
+    // backward DP: the cost to go of a state at node i is the least stage cost at node i + 1 plus the cost to go of
+    // a successor. Every state of a feasible value gets one, whether or not the forward DP reaches it.
+    std::vector<std::int32_t> next(static_cast<std::size_t>(N) * S, -1);
+    std::vector<double> cost(static_cast<std::size_t>(N) * S, std::numeric_limits<double>::infinity());
+    for (std::size_t t = 0; t < S; ++t)
+        if (_feasible[N - 1][_state_value[t]])
+            cost[(N - 1) * S + t] = 0;
+
+    auto stage_cost = [&](int i, std::size_t w, const std::vector<double> &col) {
+        const std::vector<double> c = _dp.stage_cost(_values[w], col, i, _dp.dt);
+        if (c.size() != 1)
+            throw std::runtime_error("Error: a policy requires stage_cost to return a single element.");
+        return c[0];
+    };
+
+    std::vector<double> col, c(_values.size());
+    for (int i = N - 2; i >= 0; --i) {
+        v_rel.column(i + 1, col);
+        for (std::size_t w = 0; w < _values.size(); ++w)
+            if (_feasible[i + 1][w])
+                c[w] = stage_cost(i + 1, w, col);
+
+        // successors are visited in increasing order, so the first one wins ties.
+        const double *J_nxt = cost.data() + (i + 1) * S;
+        double *J = cost.data() + i * S;
+        for (std::size_t t = 0; t < S; ++t) {
+            if (J_nxt[t] == std::numeric_limits<double>::infinity())
+                continue;
+            const double candidate = c[_state_value[t]] + J_nxt[t];
+            for (std::uint32_t e = _in_offset[t]; e < _in_offset[t + 1]; ++e) {
+                const std::uint32_t s = _in_source[e];
+                if (!_feasible[i][_state_value[s]] || candidate >= J[s])
+                    continue;
+                J[s] = candidate;
+                next[i * S + s] = static_cast<std::int32_t>(t);
+            }
+        }
+    }
+
+    // the start is the initial state with the least stage cost at node 0 plus cost to go.
+    std::int32_t start = -1;
+    double start_best = std::numeric_limits<double>::infinity();
+    v_rel.column(0, col);
+    for (std::size_t s = 0; s < _n_init; ++s) {
+        if (cost[s] == std::numeric_limits<double>::infinity())
+            continue;
+        const double objective = stage_cost(0, _state_value[s], col) + cost[s];
+        if (start < 0 || objective < start_best) {
+            start = static_cast<std::int32_t>(s);
+            start_best = objective;
+        }
+    }
+
+    return Policy::from_tables(N, _values, _slots, _state_value, _state_steps, next, cost, start);
+}
+
+int StateGraph::_steps(double timer) const {
+    int steps = 0;
+    for (timer -= _dp.dt; timer > 0; timer -= _dp.dt)
+        ++steps;
+    return steps;
+}
+
+bool StateGraph::_transition(const int *steps, int u, int w, int *next) const {
+    const ProblemConfig::disc_vector &vi = _values[u];
+    const ProblemConfig::disc_vector &vni = _values[w];
+    const std::size_t nv = vi.size();
+
+    // mirrors Solver::_dwell_time on step counters: a timer with steps left is still positive after the next dt.
+    for (std::size_t k = 0; k < _dp.dwell_time_cons.size(); ++k) {
+        const auto &con = _dp.dwell_time_cons[k];
+        for (std::size_t idx = 0; idx < nv; ++idx) {
+            const std::size_t slot = k * nv + idx;
+            const bool active = steps[slot] > 0;
+            next[slot] = active ? steps[slot] - 1 : 0;
+
+            if (vni[idx] == vi[idx])
+                continue;
+            if (active && vi[idx] == con.first.back())
+                return false;
+
+            auto it = std::find(con.first.begin(), con.first.end(), vni[idx]);
+            if (it == con.first.end())
+                continue;
+            std::size_t vni_idx = std::distance(con.first.begin(), it);
+            if (vni_idx == 0)
+                next[slot] = _fresh[slot];
+            else if (con.first[vni_idx - 1] != vi[idx])
+                next[slot] = 0;
+        }
+    }
+    return true;
+}
+
+}
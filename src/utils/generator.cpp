@@ -0,0 +1,196 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "../../include/generator.h"
+#include "../../include/vector_ops.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <stdexcept>
+
+namespace DPapprox {
+
+namespace {
+
+// the engine is specified exactly by the standard, the distributions are not, so they are written out here to get
+// the same inputs from the same seed on every platform.
+double uniform(std::mt19937_64 &rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+double gaussian(std::mt19937_64 &rng) {
+    const double u = 1.0 - uniform(rng);
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * uniform(rng));
+}
+
+void check(const GeneratorSpec &spec) {
+    if (spec.N < 1 || spec.nv < 1 || spec.levels < 2 || spec.dt <= 0 || spec.smoothness <= 0 ||
+        spec.chattering < 0 || spec.min_dwell_time < 0 || spec.tau <= 0)
+        throw std::runtime_error("Error: invalid generator spec.");
+}
+
+std::string trim(const std::string &s) {
+    const std::size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return "";
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+}
+
+std::vector<std::vector<double>> generate_relaxed(const GeneratorSpec &spec) {
+    check(spec);
+    std::mt19937_64 rng(spec.seed);
+    const double top = spec.levels - 1;
+
+    // each input is a smooth AR(1) process squashed into [0, levels - 1], plus an alternating chattering component.
+    const double a = std::exp(-1.0 / (spec.smoothness * spec.N));
+    const double b = std::sqrt(1.0 - a * a);
+    std::vector<std::vector<double>> v_rel(spec.nv, std::vector<double>(spec.N));
+    for (std::vector<double> &row: v_rel) {
+        double s = gaussian(rng);
+        for (int i = 0; i < spec.N; ++i) {
+            double r = top * (0.5 + 0.5 * std::tanh(s));
+            r += spec.chattering * ((i % 2 == 0) ? 1.0 : -1.0) * uniform(rng);
+            row[i] = std::clamp(r, 0.0, top);
+            s = a * s + b * gaussian(rng);
+        }
+    }
+    return v_rel;
+}
+
+ProblemConfig generate_config(const GeneratorSpec &spec) {
+    check(spec);
+    const std::size_t nv = spec.nv;
+    if (std::pow(spec.levels, static_cast<double>(nv)) > 1e6)
+        throw std::runtime_error("Error: levels^nv is too large for the feasible set.");
+
+    // the feasible values are all combinations of the levels, the first input varying fastest.
+    std::vector<ProblemConfig::disc_vector> values{ProblemConfig::disc_vector{}};
+    for (std::size_t k = 0; k < nv; ++k) {
+        std::vector<ProblemConfig::disc_vector> expanded;
+        for (int l = 0; l < spec.levels; ++l)
+            for (const ProblemConfig::disc_vector &v: values) {
+                expanded.push_back(v);
+                expanded.back().push_back(l);
+            }
+        values.swap(expanded);
+    }
+
+    ProblemConfig config;
+    config.N = spec.N;
+    config.dt = spec.dt;
+    config.v_feasible.assign(config.N, values);
+    config.stage_cost = [](const ProblemConfig::disc_vector &vi, const std::vector<double> &ri, int, double dt) {
+        return (vi - ri) * dt;
+    };
+    if (nv == 1) {
+        config.objective = ProblemConfig::abs_objective;
+    } else {
+        config.objective = [](const std::vector<double> &x) {
+            double m = 0;
+            for (double xk: x)
+                m = std::max(m, std::abs(xk));
+            return m;
+        };
+    }
+
+    if (spec.min_dwell_time > 0)
+        for (int l = 0; l < spec.levels; ++l)
+            config.dwell_time_cons.push_back({{l}, std::vector<double>(nv, spec.min_dwell_time)});
+
+    if (spec.state) {
+        const double tau = spec.tau, bound = spec.state_bound;
+        config.include_state = true;
+        config.x0.assign(nv, 0.0);
+        config.state_transition = [tau](const ProblemConfig::traj_vector &x, const ProblemConfig::disc_vector &vi,
+                                         int, double dt) {
+            return x + (vi - x) * (dt / tau);
+        };
+        config.state_cost = [bound](const ProblemConfig::traj_vector &x, const std::vector<double> &, int, double) {
+            for (double xk: x)
+                if (xk > bound)
+                    return std::vector<double>{1e20};
+            return std::vector<double>{0};
+        };
+    }
+    return config;
+}
+
+void set_spec(GeneratorSpec &spec, const std::string &key, const std::string &value) {
+    try {
+        if (key == "N")
+            spec.N = std::stoi(value);
+        else if (key == "nv")
+            spec.nv = std::stoul(value);
+        else if (key == "levels")
+            spec.levels = std::stoi(value);
+        else if (key == "dt")
+            spec.dt = std::stod(value);
+        else if (key == "smoothness")
+            spec.smoothness = std::stod(value);
+        else if (key == "chattering")
+            spec.chattering = std::stod(value);
+        else if (key == "min_dwell_time")
+            spec.min_dwell_time = std::stod(value);
+        else if (key == "state")
+            spec.state = std::stoi(value) != 0;
+        else if (key == "tau")
+            spec.tau = std::stod(value);
+        else if (key == "state_bound")
+            spec.state_bound = std::stod(value);
+        else if (key == "seed")
+            spec.seed = std::stoull(value);
+        else
+            throw std::runtime_error("Error: unknown generator key " + key + ".");
+    }
+    catch (const std::logic_error &) {
+        throw std::runtime_error("Error: invalid value " + value + " of generator key " + key + ".");
+    }
+}
+
+void write_spec(const std::string &filename, const GeneratorSpec &spec) {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Error: Cannot open file " + filename + " for writing.");
+    file.precision(17);
+    file << "N = " << spec.N << "\n"
+         << "nv = " << spec.nv << "\n"
+         << "levels = " << spec.levels << "\n"
+         << "dt = " << spec.dt << "\n"
+         << "smoothness = " << spec.smoothness << "\n"
+         << "chattering = " << spec.chattering << "\n"
+         << "min_dwell_time = " << spec.min_dwell_time << "\n"
+         << "state = " << (spec.state ? 1 : 0) << "\n"
+         << "tau = " << spec.tau << "\n"
+         << "state_bound = " << spec.state_bound << "\n"
+         << "seed = " << spec.seed << "\n";
+}
+
+GeneratorSpec read_spec(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Error: Cannot open file " + filename + ".");
+
+    GeneratorSpec spec;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        const std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            throw std::runtime_error("Error: invalid line " + line + " in " + filename + ".");
+        set_spec(spec, trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+    }
+    return spec;
+}
+
+}
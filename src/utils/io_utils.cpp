@@ -13,11 +13,11 @@
 #include <sstream>
 
 
-void DPapprox::write_csv(const std::string& filename, const std::vector<std::vector<double>>& data) {
+bool DPapprox::write_csv(const std::string& filename, const std::vector<std::vector<double>>& data) {
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file " << filename << " for writing." << std::endl;
-        return;
+        return false;
     }
 
     for (const DPapprox::ProblemConfig::disc_vector& row : data) {
@@ -32,6 +32,11 @@ void DPapprox::write_csv(const std::string& filename, const std::vector<std::vec
     }
 
     file.close();
+    if (file.fail()) {
+        std::cerr << "Error: Cannot write file " << filename << "." << std::endl;
+        return false;
+    }
+    return true;
 }
 
 
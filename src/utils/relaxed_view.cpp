@@ -0,0 +1,48 @@
+/* This file is part of DPapprox
+ * Copyright (C) 2025 Ramin Abbasi Esfeden.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This software is based on research described in:
+ * "A Dynamic Programming-Inspired Approach for Mixed Integer Optimal Control Problems with Dwell Time Constraints,"
+ * by Ramin Abbasi Esfeden, Christoph Plate, Sebastian Sager, Jan Swevers, 2025.
+ */
+
+#include "relaxed_view.h"
+#include <algorithm>
+
+namespace DPapprox {
+
+RelaxedView::RelaxedView(const std::vector<std::vector<double>> &v_rel) {
+    _row.reserve(v_rel.size());
+    _cols = v_rel.empty() ? 0 : v_rel[0].size();
+    for (const auto &row: v_rel) {
+        _row.push_back(row.data());
+        _cols = std::min(_cols, row.size());
+    }
+}
+
+RelaxedView::RelaxedView(const double *data, std::size_t rows, std::size_t cols,
+                         std::ptrdiff_t row_stride, std::ptrdiff_t col_stride)
+    : _cols(cols), _col_stride(col_stride)
+{
+    _row.reserve(rows);
+    for (std::size_t r = 0; r < rows; ++r)
+        _row.push_back(data + static_cast<std::ptrdiff_t>(r) * row_stride);
+}
+
+RelaxedView::RelaxedView(const float *data, std::size_t rows, std::size_t cols,
+                         std::ptrdiff_t row_stride, std::ptrdiff_t col_stride)
+    : _cols(cols), _col_stride(col_stride)
+{
+    _row_single.reserve(rows);
+    for (std::size_t r = 0; r < rows; ++r)
+        _row_single.push_back(data + static_cast<std::ptrdiff_t>(r) * row_stride);
+}
+
+void RelaxedView::column(std::size_t i, std::vector<double> &out) const {
+    out.resize(rows());
+    for (std::size_t r = 0; r < out.size(); ++r)
+        out[r] = at(r, i);
+}
+
+}
@@ -61,4 +61,15 @@ std::vector<double> operator*(const std::vector<double> &vec, double scalar) {
     return result;
 }
 
+
+void add(const double *a, std::size_t na, const double *b, std::size_t nb, std::vector<double> &out) {
+    if (na != nb && na != 1 && nb != 1)
+        throw std::runtime_error("Vector addition error: incompatible sizes.");
+
+    const std::size_t n = (na == 1) ? nb : na;
+    out.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[na == 1 ? 0 : i] + b[nb == 1 ? 0 : i];
+}
+
 }